@@ -0,0 +1,82 @@
+#include "bench_timer.hpp"
+#include <inputs/keyboard.hpp>
+#include <string>
+
+// Event dispatch and per-frame update with 500 mapped actions, each bound to
+// two of 40 keys and carrying press, release and hold callbacks. Key events
+// should only touch the actions on that key, and hold callbacks only the
+// actions that are held.
+
+using namespace Keyboard;
+
+namespace {
+    constexpr int REPEATS = 5;
+    constexpr int ACTION_COUNT = 500;
+    constexpr int KEY_EVENTS = 2000;
+    constexpr int UPDATES = 1000;
+
+    const SDL_Keycode KEYS[] = {
+        SDLK_A, SDLK_B, SDLK_C, SDLK_D, SDLK_E, SDLK_F, SDLK_G, SDLK_H, SDLK_I, SDLK_J,
+        SDLK_K, SDLK_L, SDLK_M, SDLK_N, SDLK_O, SDLK_P, SDLK_Q, SDLK_R, SDLK_S, SDLK_T,
+        SDLK_U, SDLK_V, SDLK_W, SDLK_X, SDLK_Y, SDLK_Z, SDLK_LEFT, SDLK_RIGHT, SDLK_UP, SDLK_DOWN,
+        SDLK_F1, SDLK_F2, SDLK_F3, SDLK_F4, SDLK_F5, SDLK_F6, SDLK_F7, SDLK_F8, SDLK_F9, SDLK_F10,
+    };
+    constexpr int KEY_COUNT = sizeof(KEYS) / sizeof(KEYS[0]);
+
+    SDL_Event keyEvent(SDL_Keycode key, bool down) {
+        SDL_Event event{};
+        event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+        event.key.key = key;
+        event.key.scancode = SDL_GetScancodeFromKey(key, nullptr);
+        event.key.down = down;
+        return event;
+    }
+}
+
+int main() {
+    KeyboardManager input("");
+    uint64_t calls = 0;
+    auto count = [&calls]() { calls++; };
+    for (int i = 0; i < ACTION_COUNT; i++) {
+        ActionId action = input.mapAction("ACTION_" + std::to_string(i), KEYS[(i * 7) % KEY_COUNT], KEYS[(i * 13 + 5) % KEY_COUNT]);
+        input.registerActionCallback(action, count, count, count);
+    }
+
+    uint64_t eventNs = bestOfNs(REPEATS, [&]() {
+        for (int i = 0; i < KEY_EVENTS; i += 2) {
+            SDL_Keycode key = KEYS[i % KEY_COUNT];
+            input.handleEvent(keyEvent(key, true));
+            input.handleEvent(keyEvent(key, false));
+        }
+    });
+    input.update();
+
+    // Three keys held: only their actions run hold callbacks
+    const SDL_Keycode heldKeys[] = {SDLK_W, SDLK_LEFT, SDLK_F3};
+    for (SDL_Keycode key : heldKeys) {
+        input.handleEvent(keyEvent(key, true));
+    }
+    input.update();
+    uint64_t heldUpdateNs = bestOfNs(REPEATS, [&]() {
+        for (int i = 0; i < UPDATES; i++) {
+            input.update();
+        }
+    });
+    for (SDL_Keycode key : heldKeys) {
+        input.handleEvent(keyEvent(key, false));
+    }
+    input.update();
+
+    uint64_t idleUpdateNs = bestOfNs(REPEATS, [&]() {
+        for (int i = 0; i < UPDATES; i++) {
+            input.update();
+        }
+    });
+
+    reportBench("500 actions, key event", eventNs, KEY_EVENTS, "event");
+    reportBench("500 actions, update with 3 keys held", heldUpdateNs, UPDATES, "update");
+    reportBench("500 actions, update with nothing held", idleUpdateNs, UPDATES, "update");
+
+    keepResult(calls);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "bench_timer.hpp"
+#include <inputs/keyboard.hpp>
+#include <string>
+#include <vector>
+
+// isActionPressed by ActionId next to the string API it replaced, with names
+// passed as literals (a temporary std::string per call) and as prebuilt
+// strings. 10k queries per frame over 64 mapped actions, a few of them held.
+
+using namespace Keyboard;
+
+namespace {
+    constexpr int REPEATS = 5;
+    constexpr int FRAMES = 200;
+    constexpr int QUERIES_PER_FRAME = 10000;
+    constexpr int ACTION_COUNT = 64;
+
+    SDL_Event keyEvent(SDL_Keycode key) {
+        SDL_Event event{};
+        event.type = SDL_EVENT_KEY_DOWN;
+        event.key.key = key;
+        event.key.scancode = SDL_GetScancodeFromKey(key, nullptr);
+        event.key.down = true;
+        return event;
+    }
+}
+
+int main() {
+    KeyboardManager input("");
+    std::vector<std::string> names;
+    std::vector<ActionId> ids;
+    for (int i = 0; i < ACTION_COUNT; i++) {
+        names.push_back("ACTION_" + std::to_string(i));
+        ids.push_back(input.mapAction(names.back(), static_cast<SDL_Keycode>('a' + i % 26)));
+    }
+    ActionId jump = input.mapAction("JUMP", SDLK_SPACE);
+    for (SDL_Keycode key : {SDLK_SPACE, SDLK_A, SDLK_D}) {
+        input.handleEvent(keyEvent(key));
+    }
+
+    uint64_t hits = 0;
+    uint64_t idNs = bestOfNs(REPEATS, [&]() {
+        for (int frame = 0; frame < FRAMES; frame++) {
+            input.update();
+            for (int i = 0; i < QUERIES_PER_FRAME; i += 2) {
+                hits += input.isActionPressed(jump);
+                hits += input.isActionPressed(ids[i % ACTION_COUNT]);
+            }
+        }
+    });
+
+    uint64_t literalNs = bestOfNs(REPEATS, [&]() {
+        for (int frame = 0; frame < FRAMES; frame++) {
+            input.update();
+            for (int i = 0; i < QUERIES_PER_FRAME; i += 2) {
+                hits += input.isActionPressed("JUMP");
+                hits += input.isActionPressed(i % 2 == 0 ? "ACTION_3" : "ACTION_40");
+            }
+        }
+    });
+
+    uint64_t stringNs = bestOfNs(REPEATS, [&]() {
+        const std::string jumpName = "JUMP";
+        for (int frame = 0; frame < FRAMES; frame++) {
+            input.update();
+            for (int i = 0; i < QUERIES_PER_FRAME; i += 2) {
+                hits += input.isActionPressed(jumpName);
+                hits += input.isActionPressed(names[i % ACTION_COUNT]);
+            }
+        }
+    });
+
+    uint64_t queries = static_cast<uint64_t>(FRAMES) * QUERIES_PER_FRAME;
+    reportBench("isActionPressed(ActionId)", idNs, queries, "query");
+    reportBench("isActionPressed(\"literal\")", literalNs, queries, "query");
+    reportBench("isActionPressed(const std::string&)", stringNs, queries, "query");
+    std::printf("ActionId queries are %.1fx faster than literals\n", static_cast<double>(literalNs) / idNs);
+
+    keepResult(hits);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <cstdio>
+
+// Timing for the engine benchmarks. Each measurement runs a few times and
+// keeps the fastest run, the one least disturbed by the rest of the system.
+
+// Results go here so the compiler can't drop the work that produced them
+inline volatile uint64_t benchSink = 0;
+
+template <typename T>
+inline void keepResult(T value) {
+    benchSink = benchSink + static_cast<uint64_t>(value);
+}
+
+// Fastest of `repeats` calls to body(), in nanoseconds
+template <typename Body>
+uint64_t bestOfNs(int repeats, Body&& body) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < repeats; i++) {
+        uint64_t start = SDL_GetTicksNS();
+        body();
+        uint64_t elapsed = SDL_GetTicksNS() - start;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+// One result line: time per operation and operations per second
+inline void reportBench(const char* name, uint64_t elapsedNs, uint64_t operations, const char* unit) {
+    double perOperation = static_cast<double>(elapsedNs) / static_cast<double>(operations);
+    std::printf("%-44s %12.2f ns/%-8s %14.0f %s/s\n", name, perOperation, unit, 1e9 / perOperation, unit);
+}
@@ -0,0 +1,77 @@
+#include "bench_timer.hpp"
+#include <audio/audio.hpp>
+#include <audio/granular.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Cost of one second of audio from a granular voice with about 200
+// overlapping grains, next to N plain voices each rendering their one-second
+// waveform. Nothing is opened on an audio device.
+// Usage: granular_bench [plain voices] (default 16)
+
+namespace {
+    constexpr int REPEATS = 5;
+    constexpr int SAMPLE_RATE = 48000;
+    constexpr int BLOCK_FRAMES = 512;
+    constexpr int BLOCKS_PER_SECOND = (SAMPLE_RATE + BLOCK_FRAMES - 1) / BLOCK_FRAMES;
+}
+
+int main(int argc, char** argv) {
+    int plainVoices = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 16;
+
+    AudioSystem source(SAMPLE_RATE);
+    source.ClearWaveComponents();
+    source.AddWaveComponent(WaveType::Sine, 220.0f, 0.5f);
+    source.AddWaveComponent(WaveType::Triangle, 330.0f, 0.5f);
+    source.GenerateComplexWave();
+
+    // 4000 grains a second, 50 ms each: 200 in flight at any time
+    GranularParams params;
+    params.grainsPerSecond = 4000.0f;
+    params.grainDurationMs = 50.0f;
+    GranularVoice voice;
+    voice.SetParams(params);
+    voice.SetSource(source.GetWaveData(), SAMPLE_RATE);
+
+    std::vector<float> left(BLOCK_FRAMES);
+    std::vector<float> right(BLOCK_FRAMES);
+    uint64_t grainSum = 0;
+    uint64_t granularNs = bestOfNs(REPEATS, [&]() {
+        grainSum = 0;
+        for (int block = 0; block < BLOCKS_PER_SECOND; block++) {
+            std::fill(left.begin(), left.end(), 0.0f);
+            std::fill(right.begin(), right.end(), 0.0f);
+            voice.Render(left.data(), right.data(), BLOCK_FRAMES);
+            grainSum += voice.GetActiveGrainCount();
+        }
+    });
+    keepResult(left[0] + right[0]);
+    std::printf("granular voice: %.0f grains in flight on average\n",
+                static_cast<double>(grainSum) / BLOCKS_PER_SECOND);
+    reportBench("granular voice, 1 s of audio", granularNs, BLOCKS_PER_SECOND * BLOCK_FRAMES, "frame");
+
+    // Plain voices render their whole waveform up front
+    std::vector<std::unique_ptr<AudioSystem>> voices;
+    for (int i = 0; i < plainVoices; i++) {
+        auto plain = std::make_unique<AudioSystem>(SAMPLE_RATE);
+        plain->ClearWaveComponents();
+        plain->AddWaveComponent(WaveType::Sine, 220.0f + 20.0f * i, 0.5f);
+        plain->AddWaveComponent(WaveType::Triangle, 330.0f + 20.0f * i, 0.5f);
+        voices.push_back(std::move(plain));
+    }
+    uint64_t plainNs = bestOfNs(REPEATS, [&voices]() {
+        for (auto& plain : voices) {
+            plain->GenerateComplexWave();
+        }
+    });
+    keepResult(voices.back()->GetWaveData()[SAMPLE_RATE / 2]);
+    char name[64];
+    std::snprintf(name, sizeof(name), "%d plain voices, 1 s of audio each", plainVoices);
+    reportBench(name, plainNs, static_cast<uint64_t>(plainVoices) * SAMPLE_RATE, "frame");
+
+    double perPlainVoice = static_cast<double>(plainNs) / plainVoices;
+    std::printf("one granular voice costs as much as %.1f plain voices\n", granularNs / perPlainVoice);
+    return 0;
+}
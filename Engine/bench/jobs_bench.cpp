@@ -0,0 +1,61 @@
+#include "bench_timer.hpp"
+#include <threading/job_system.hpp>
+#include <cstdlib>
+#include <vector>
+
+// Job system overhead: throughput of empty jobs, and parallelFor over a
+// million elements at a few grain sizes next to a plain loop.
+// Usage: jobs_bench [workers] (default: one per core)
+
+using namespace Threading;
+
+namespace {
+    constexpr int REPEATS = 5;
+    constexpr size_t EMPTY_JOBS = 1000000;
+    // Unfinished jobs per thread are capped by the pool, so submit in batches
+    constexpr size_t EMPTY_JOB_BATCH = JobSystem::JOB_POOL_SIZE / 2;
+    constexpr size_t ELEMENTS = 1000000;
+
+    void scale(std::vector<float>& values, size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            values[i] = values[i] * 1.0001f + 0.5f;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Jobs.start(argc > 1 ? std::atoi(argv[1]) : 0);
+
+    uint64_t emptyNs = bestOfNs(REPEATS, []() {
+        for (size_t submitted = 0; submitted < EMPTY_JOBS; submitted += EMPTY_JOB_BATCH) {
+            JobCounter counter;
+            for (size_t i = 0; i < EMPTY_JOB_BATCH; i++) {
+                Jobs.submit([]() {}, &counter);
+            }
+            Jobs.wait(counter);
+        }
+    });
+    reportBench("empty jobs", emptyNs, EMPTY_JOBS, "job");
+
+    std::vector<float> values(ELEMENTS, 1.0f);
+    uint64_t serialNs = bestOfNs(REPEATS, [&values]() {
+        scale(values, 0, values.size());
+    });
+    reportBench("serial loop, 1M elements", serialNs, ELEMENTS, "element");
+
+    const size_t grains[] = {0, 1024, 16384, 131072};
+    for (size_t grain : grains) {
+        uint64_t parallelNs = bestOfNs(REPEATS, [&values, grain]() {
+            Jobs.parallelFor(0, values.size(), grain, [&values](size_t first, size_t last) {
+                scale(values, first, last);
+            });
+        });
+        char name[64];
+        std::snprintf(name, sizeof(name), "parallelFor, 1M elements, grain %zu", grain);
+        reportBench(name, parallelNs, ELEMENTS, "element");
+    }
+    keepResult(values[ELEMENTS / 2]);
+
+    Jobs.stop();
+    return 0;
+}
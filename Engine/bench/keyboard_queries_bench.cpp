@@ -0,0 +1,77 @@
+#include "bench_timer.hpp"
+#include <inputs/keyboard.hpp>
+
+// Key state queries at gameplay rates: each frame flips the key state once and
+// then answers 10k pressed / just-pressed / just-released queries, by keycode
+// and by scancode, with a few keys held and one tapped per frame.
+
+using namespace Keyboard;
+
+namespace {
+    constexpr int REPEATS = 5;
+    constexpr int FRAMES = 1000;
+    constexpr int QUERIES_PER_FRAME = 10000;
+
+    const SDL_Keycode QUERIED_KEYS[] = {
+        SDLK_W, SDLK_A, SDLK_S, SDLK_D, SDLK_SPACE, SDLK_LSHIFT, SDLK_E, SDLK_Q,
+        SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT, SDLK_F5, SDLK_ESCAPE, SDLK_1, SDLK_TAB,
+    };
+    constexpr int QUERIED_KEY_COUNT = sizeof(QUERIED_KEYS) / sizeof(QUERIED_KEYS[0]);
+
+    SDL_Event keyEvent(SDL_Keycode key, bool down) {
+        SDL_Event event{};
+        event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+        event.key.key = key;
+        event.key.scancode = SDL_GetScancodeFromKey(key, nullptr);
+        event.key.down = down;
+        return event;
+    }
+}
+
+int main() {
+    KeyboardManager input("");
+    for (SDL_Keycode key : {SDLK_W, SDLK_LSHIFT, SDLK_RIGHT}) {
+        input.handleEvent(keyEvent(key, true));
+    }
+
+    SDL_Scancode queriedScancodes[QUERIED_KEY_COUNT];
+    for (int i = 0; i < QUERIED_KEY_COUNT; i++) {
+        queriedScancodes[i] = input.toScancode(QUERIED_KEYS[i]);
+    }
+
+    uint64_t hits = 0;
+    uint64_t keycodeNs = bestOfNs(REPEATS, [&]() {
+        for (int frame = 0; frame < FRAMES; frame++) {
+            // One tap per frame keeps the edge queries honest
+            input.handleEvent(keyEvent(SDLK_SPACE, frame % 2 == 0));
+            input.update();
+            for (int i = 0; i < QUERIES_PER_FRAME; i += 4) {
+                SDL_Keycode key = QUERIED_KEYS[i % QUERIED_KEY_COUNT];
+                hits += input.isKeyPressed(key);
+                hits += input.isKeyJustPressed(key);
+                hits += input.isKeyJustReleased(key);
+                hits += input.isKeyPressed(static_cast<SDL_Keycode>('a' + i % 26));
+            }
+        }
+    });
+    reportBench("10k keycode queries per frame", keycodeNs, static_cast<uint64_t>(FRAMES) * QUERIES_PER_FRAME, "query");
+    reportBench("frame of 10k keycode queries", keycodeNs, FRAMES, "frame");
+
+    uint64_t scancodeNs = bestOfNs(REPEATS, [&]() {
+        for (int frame = 0; frame < FRAMES; frame++) {
+            input.handleEvent(keyEvent(SDLK_SPACE, frame % 2 == 0));
+            input.update();
+            for (int i = 0; i < QUERIES_PER_FRAME; i += 4) {
+                SDL_Scancode scancode = queriedScancodes[i % QUERIED_KEY_COUNT];
+                hits += input.isKeyPressed(scancode);
+                hits += input.isKeyJustPressed(scancode);
+                hits += input.isKeyJustReleased(scancode);
+                hits += input.isKeyPressed(static_cast<SDL_Scancode>(SDL_SCANCODE_A + i % 26));
+            }
+        }
+    });
+    reportBench("10k scancode queries per frame", scancodeNs, static_cast<uint64_t>(FRAMES) * QUERIES_PER_FRAME, "query");
+
+    keepResult(hits);
+    return 0;
+}
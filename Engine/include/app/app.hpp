@@ -4,7 +4,12 @@
 #include <string>
 #include <memory>
 #include <renderer/renderer.hpp>
+#include <renderer/render_thread.hpp>
 #include <assets/piano/piano.hpp> // Added piano include
+#include <inputs/input_recording.hpp>
+#include <inputs/input_thread.hpp>
+#include <app/frame_scheduler.hpp>
+#include <threading/task_graph.hpp>
 
 class App {
 public:
@@ -14,6 +19,13 @@ public:
     // Destructor for cleanup
     ~App();
     
+    // Headless mode runs the same loop without a window, renderer or GPU (CI
+    // and benchmarks); call before initialize()
+    void setHeadless(bool enabled) { headless = enabled; }
+    
+    // Stop after this many frames and print a timing summary (0 = run until quit)
+    void setFrameLimit(uint64_t frames) { frameLimit = frames; }
+    
     // Initialize the App
     bool initialize();
     
@@ -23,10 +35,20 @@ public:
     // Process input events
     void processEvents();
     
-    // Update App state
+    // Input recording and replay; call before run()
+    bool startInputRecording(const std::string& path);
+    bool startInputReplay(const std::string& path, ReplayMode mode, bool quitWhenFinished);
+    
+    // Write the first frame's task graph with per-system timings (Graphviz)
+    void exportFrameGraph(const std::string& path);
+    
+    // Update App state: runs the frame's systems (input, game logic in fixed
+    // steps, audio) on the job system
     void update();
+    void fixedUpdate(double deltaSeconds);
     
-    // Render the current frame
+    // Snapshot the current frame and draw it, or hand it to the render thread
+    // in pipelined mode
     void render();
 
 private:
@@ -41,6 +63,39 @@ private:
     // Renderer instance
     std::unique_ptr<Renderer> renderer;
     
+    // Draws the snapshots in pipelined mode (renderMode setting)
+    RenderThread renderThread;
+    bool windowResized = false;
+    void drawSnapshot(const RenderSnapshot& snapshot);
+    
     // App state
     bool running;
+    bool headless = false;
+    uint64_t frameIndex = 0;
+    uint64_t frameLimit = 0;
+    
+    // Frame timings for the summary printed after headless or limited runs
+    uint64_t runStartNs = 0;
+    uint64_t frameWorkTotalNs = 0;
+    uint64_t frameWorkMinNs = UINT64_MAX;
+    uint64_t frameWorkMaxNs = 0;
+    void printRunSummary() const;
+    
+    // Fixed simulation timestep and the maxFPS frame limiter
+    FrameScheduler frameScheduler;
+    
+    // Systems run by update(), ordered by the resources they read and write
+    Threading::TaskGraph frameGraph;
+    void buildFrameGraph();
+    
+    // Delivers key events to the piano as soon as they are pumped
+    InputThread inputThread;
+    
+    // Input recording and replay
+    InputRecorder inputRecorder;
+    InputReplayer inputReplayer;
+    bool quitAfterReplay = false;
+    
+    // Hand one event to every consumer (live or replayed)
+    void dispatchEvent(const SDL_Event& event);
 };
\ No newline at end of file
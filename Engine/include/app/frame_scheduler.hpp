@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Paces the main loop. Game logic advances in fixed steps fed by a smoothed
+// frame delta; rendering gets the interpolation factor between the last two
+// steps. The frame limiter sleeps for most of the wait and spins the rest,
+// using a running estimate of how far the OS oversleeps; while it sleeps it
+// pumps OS events every millisecond so the input thread sees them early.
+class FrameScheduler {
+public:
+    static constexpr int MAX_STEPS_PER_FRAME = 5;                  // beyond this the simulation slows down instead of spiralling
+    static constexpr uint64_t MAX_FRAME_DELTA_NS = 250000000;      // hitches (breakpoints, window drags) count as 250 ms
+    static constexpr size_t SMOOTHING_FRAMES = 4;                  // frame deltas averaged for the simulation
+
+    // maxFPS <= 0 disables the limiter (vsync or the GPU then set the pace)
+    void configure(int maxFPS, int simulationHz);
+
+    // Call once at the top of each frame
+    void beginFrame();
+
+    // True while another fixed step is due this frame
+    bool consumeFixedStep();
+
+    // Sleep, then spin, until the next frame is due under maxFPS. Main thread
+    // only, since it pumps OS events.
+    void waitForNextFrame();
+
+    double getFixedDeltaSeconds() const { return static_cast<double>(fixedStepNs) / 1e9; }
+    float getInterpolationAlpha() const;  // 0..1 between the previous and the latest fixed step
+    uint64_t getFrameDeltaNs() const { return frameDeltaNs; }
+    uint64_t getSmoothedDeltaNs() const { return smoothedDeltaNs; }
+    uint64_t getDroppedSteps() const { return droppedSteps; }
+
+private:
+    void sleepUntil(uint64_t deadlineNs);
+
+    uint64_t framePeriodNs = 0;     // 0 = unlimited
+    uint64_t fixedStepNs = 16666667;
+
+    // Frame timing
+    uint64_t frameStartNs = 0;
+    uint64_t nextFrameNs = 0;
+    uint64_t frameDeltaNs = 0;
+    uint64_t smoothedDeltaNs = 0;
+    std::array<uint64_t, SMOOTHING_FRAMES> recentDeltas{};
+    size_t recentCount = 0;
+
+    // Fixed-step simulation
+    uint64_t accumulatorNs = 0;
+    int64_t smoothingDriftNs = 0;   // raw minus smoothed time not yet given to the simulation
+    int stepsThisFrame = 0;
+    uint64_t droppedSteps = 0;
+
+    // How late sleeps wake up (Welford mean/variance, window capped so it adapts)
+    double oversleepMeanNs = 1000000.0;
+    double oversleepM2 = 0.0;
+    uint64_t oversleepSamples = 0;
+};
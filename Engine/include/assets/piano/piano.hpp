@@ -1,15 +1,18 @@
 #pragma once
 
 #include <SDL3/SDL.h>
-#include <map>
+#include <audio/notes.hpp>
+#include <array>
+#include <atomic>
 #include <string>
 #include <functional>
 #include <vector>
 #include <chrono>
+#include <mutex>
 
 // Record entry structure to store note information
 struct NoteRecord {
-    std::string note;
+    NoteId note;
     int duration;
     uint64_t timestamp;
 };
@@ -25,16 +28,28 @@ public:
     // Update and handle piano input
     void update();
     
-    // Handle piano-specific key events
+    // Handle piano-specific key events (notes and recording controls)
     void handleKeyEvent(const SDL_Event& event);
     
+    // Split handlers: notes may arrive on the input thread, controls on the main thread
+    void handleNoteEvent(const SDL_Event& event);
+    void handleControlEvent(const SDL_Event& event);
+    
     // Piano controls
-    void playNote(const std::string& note, int durationMs = 1000);
+    void playNote(NoteId note, int durationMs = 1000);
+    void playNote(const std::string& noteName, int durationMs = 1000); // e.g. "C4", parsed once per call
     void toggleSustainMode();
     void stopAllNotes();
     
     // Check if sustain mode is enabled
     bool isSustainModeEnabled() const;
+    
+    // Tuning: rebuilds the note frequency table from the compile-time ratio
+    // tables. Safe while notes play on other threads; a note started during
+    // the switch gets either its old or its new frequency.
+    void setTuning(TuningSystem system, float a4Frequency = Notes::DEFAULT_A4_FREQUENCY);
+    TuningSystem getTuningSystem() const;
+    float getNoteFrequency(NoteId note) const;
 
     // Recording functionality
     void startRecording();
@@ -45,27 +60,36 @@ public:
     bool isPlaying() const;
 
 private:
-    // Map of notes to their frequencies
-    std::map<std::string, float> noteFrequencies;
+    // Frequencies of all MIDI notes for the current tuning. playNote reads them
+    // on the input thread and job workers while setTuning may rewrite them.
+    std::array<std::atomic<float>, Notes::NOTE_COUNT> noteFrequencies;
+    TuningSystem tuningSystem;
+    float referenceA4;
     
     // Sustain mode flag
     bool sustainMode;
     
-    // Maps SDL keycodes to note names
-    std::map<SDL_Keycode, std::string> keyToNoteMap;
+    // Maps SDL keycodes to note ids; piano keys are all ASCII keycodes so a
+    // flat table indexed by keycode covers them (-1 = not a piano key)
+    static constexpr SDL_Keycode KEY_TABLE_SIZE = 128;
+    std::array<int16_t, KEY_TABLE_SIZE> keyToNoteMap;
     
-    // Recording data
+    // Recording data, guarded by recordingMutex (notes are recorded from the input thread)
+    mutable std::mutex recordingMutex;
     std::vector<NoteRecord> recordedNotes;
     bool recording;
     bool playing;
     uint64_t recordStartTime;
     size_t playbackIndex;
     
-    // Initialize the note to frequency mappings
-    void initializeNoteFrequencies();
-    
     // Initialize key to note mappings
     void initializeKeyMappings();
+    
+    void storeFrequencies(const Notes::FrequencyTable& frequencies);
+    
+    // Recording helpers, called with recordingMutex held
+    void startRecordingLocked();
+    void stopRecordingLocked();
 };
 
 // Global piano instance that can be accessed from anywhere
@@ -22,10 +22,11 @@ struct WaveComponent {
 
 class AudioSystem {
 public:
-    AudioSystem();
+    AudioSystem(int sampleRate = 48000);
     ~AudioSystem();
     
-    bool Initialize();
+    // Open a private device, or bind to a shared output device owned by the mixer
+    bool Initialize(SDL_AudioDeviceID outputDevice = 0);
     void PlaySound();
     void StopSound();
     void SetFrequency(float freq);
@@ -35,17 +36,40 @@ public:
     void ClearWaveComponents();
     void GenerateComplexWave();
     
+    // Same as GenerateComplexWave but with PolyBLEP-corrected square/sawtooth
+    // edges; slower, meant for waveforms that are rendered once and cached
+    void GenerateBandLimitedWave();
+    
+    // Play an already rendered waveform (at this system's sample rate)
+    void PlaySound(const std::vector<float>& waveData);
+    
     // New asynchronous methods
     void PlaySoundAsync(int durationMs);
     void StopAsyncSound();
     bool IsPlaying() const;
     
+    // Access to the generated waveform (e.g. as a granular source)
+    const std::vector<float>& GetWaveData();
+    
+    // Device switching: move the stream to another device and/or sample rate.
+    // Already queued audio keeps playing; new audio is generated at the new rate.
+    void SetOutputDevice(SDL_AudioDeviceID outputDevice);
+    void SetSampleRate(int newSampleRate);
+    int GetSampleRate() const;
+    
+    // Latency tracing: the next PlaySound completes the trace when the device
+    // first pulls its audible samples (0 = untraced)
+    void SetLatencyTrace(uint32_t traceId);
+    
 private:
     void GenerateSineWave();
     float GenerateWaveSample(WaveType type, float phase, float amplitude);
+    float GenerateBandLimitedSample(WaveType type, double cycle, double cycleStep, float amplitude);
     void ApplyFades(); // New method to apply fade-in and fade-out effects
+    static void SDLCALL StreamGetCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount);
     
     SDL_AudioDeviceID audioDeviceID;
+    bool ownsDevice; // false when bound to the mixer's shared device
     SDL_AudioStream* audioStream;
     SDL_AudioSpec audioSpec;
     std::vector<float> sineWaveData;
@@ -61,6 +85,12 @@ private:
     
     // For fade effects
     int fadeSamples; // Number of samples for fades
+    
+    // Latency tracing, guarded by the stream lock (the device thread reads them)
+    uint32_t latencyTrace;
+    uint32_t pendingLatencyTrace;
+    int64_t leadInBytes;      // silence still queued ahead of the traced sound
+    uint64_t deviceBufferNs;  // one device buffer, the time a mixed block waits before playing
 };
 
 // Helper functions for simpler usage
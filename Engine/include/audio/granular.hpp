@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cstdint>
+
+// Parameters controlling how a granular voice emits grains
+struct GranularParams {
+    float grainsPerSecond = 400.0f;  // grain emission density
+    float grainDurationMs = 50.0f;   // length of a single grain
+    float position = 0.5f;           // read position in the source buffer (0..1)
+    float positionJitter = 0.1f;     // random offset added to the position (0..1)
+    float pitch = 1.0f;              // playback rate of each grain
+    float pitchJitter = 0.05f;       // random pitch deviation (ratio)
+    float panJitter = 0.5f;          // random stereo spread (0 = center, 1 = full)
+    float amplitude = 0.5f;          // overall voice gain
+};
+
+// A voice that plays many short windowed grains taken from a source buffer.
+// Grains live in a fixed-size pool laid out as structure-of-arrays so the
+// windowing and interpolation can be processed eight samples at a time.
+class GranularVoice {
+public:
+    static constexpr int MAX_GRAINS = 256;
+
+    GranularVoice();
+    ~GranularVoice();
+
+    // Open a stereo output stream that pulls audio from this voice. With an
+    // output device the stream is bound to it, otherwise a private device is opened.
+    bool Initialize(SDL_AudioDeviceID outputDevice = 0, int sampleRate = 48000);
+
+    // Device switching: live grains are rescaled, nothing is reallocated
+    void SetOutputDevice(SDL_AudioDeviceID outputDevice);
+    void SetSampleRate(int newSampleRate);
+    int GetSampleRate() const;
+
+    // Source material and grain parameters
+    void SetSource(const std::vector<float>& source, int sourceRate = 48000);
+    void SetParams(const GranularParams& newParams);
+    GranularParams GetParams() const;
+
+    // Playback control
+    void Play();
+    void Stop();
+
+    // Render a block of stereo audio; the result is added to the outputs
+    void Render(float* outLeft, float* outRight, int frames);
+
+    int GetActiveGrainCount() const;
+
+private:
+    static void SDLCALL StreamCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount);
+
+    void SpawnGrain(int offset);
+    void RenderGrain(int grain, float* outLeft, float* outRight, int frames);
+    float NextRandom(); // uniform in [-1, 1)
+
+    // Grain pool (structure-of-arrays, indices [0, activeGrains) are live)
+    alignas(32) float grainPosition[MAX_GRAINS];   // read position in source samples
+    alignas(32) float grainIncrement[MAX_GRAINS];  // source samples advanced per output sample
+    alignas(32) float grainPhase[MAX_GRAINS];      // window phase (0..1, negative = not started)
+    alignas(32) float grainPhaseInc[MAX_GRAINS];   // window phase advanced per output sample
+    alignas(32) float grainGainLeft[MAX_GRAINS];
+    alignas(32) float grainGainRight[MAX_GRAINS];
+    int activeGrains;
+
+    std::vector<float> sourceData;
+    GranularParams params;
+    int sampleRate;
+    int sourceSampleRate;
+    float samplesUntilNextGrain;
+    uint32_t randomState;
+
+    // Output
+    SDL_AudioStream* audioStream;
+    SDL_AudioSpec streamSpec;
+    bool ownsDevice;
+    bool active; // only feed the stream between Play() and Stop()
+    std::vector<float> mixLeft;
+    std::vector<float> mixRight;
+    std::vector<float> interleaved;
+};
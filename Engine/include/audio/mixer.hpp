@@ -1,7 +1,12 @@
 #pragma once
 
 #include <audio/audio.hpp>
+#include <audio/granular.hpp>
+#include <audio/notes.hpp>
 #include <map>
+#include <unordered_map>
+#include <list>
+#include <vector>
 #include <mutex>
 #include <memory>
 #include <string>
@@ -10,11 +15,21 @@
 // Structure for active channel information
 struct ActiveChannel {
     std::unique_ptr<AudioSystem> audioSystem;
+    std::unique_ptr<GranularVoice> granularVoice; // Set instead of audioSystem for granular channels
     std::atomic<bool> isActive;
     std::atomic<bool> isFadingOut;
     uint64_t startTime;
     uint64_t fadeDuration; // in milliseconds
     int totalDuration;     // in milliseconds
+    int note;              // MIDI note id, -1 for channels not started as a note
+};
+
+// Rendered PCM of a static sample, shared by every sample with the same components
+struct CachedWave {
+    std::vector<WaveComponent> components; // what was rendered, to tell hash collisions apart
+    int sampleRate;
+    std::vector<float> pcm;
+    std::list<uint64_t>::iterator lruPosition;
 };
 
 class AudioMixer {
@@ -28,12 +43,26 @@ public:
     // Channel management
     int PlaySound(float frequency, int durationMs);
     void StopSound(int channelId);
+    
+    // Note management (the caller resolves the frequency from its tuning)
+    int PlayNote(NoteId note, float frequency, int durationMs);
+    void StopNote(NoteId note);
     void StopAllSounds();
 
-    // Sample management
+    // Sample management. A sample is rendered on its first PlaySample, or
+    // ahead of time by PrepareSample once all its components are added.
     void AddSample(const std::string& name, WaveType type, float freq, float amplitude);
+    void PrepareSample(const std::string& name);
     void PlaySample(const std::string& name, int durationMs);
     void ClearSamples();
+    bool HasSample(const std::string& name) const;
+    
+    // Waveform cache limits (rendered sample PCM, least recently used is evicted first)
+    void SetWaveCacheLimit(size_t bytes);
+    size_t GetWaveCacheBytes() const;
+
+    // Granular playback using a named sample as the grain source
+    int PlayGranular(const std::string& name, const GranularParams& params, int durationMs);
 
     // Audio mode controls
     void ToggleSustainMode();
@@ -45,6 +74,14 @@ public:
     
     // Update method to handle fade-outs
     void Update();
+    
+    // Device hot-switching: reopen on device loss and re-prepare on rate changes
+    void HandleDeviceEvent(const SDL_Event& event);
+    int GetSampleRate() const;
+    SDL_AudioDeviceID GetOutputDevice() const;
+    
+    // Channels still playing; with a sample rate, only those prepared for it
+    int GetActiveChannelCount(int sampleRate = 0);
 
 private:
     std::map<int, std::unique_ptr<ActiveChannel>> audioChannels;
@@ -53,14 +90,42 @@ private:
     bool longSustainMode;
     uint64_t fadeOutDuration; // in milliseconds
     
+    // Shared output device all channel streams are bound to
+    SDL_AudioDeviceID outputDevice;
+    int deviceSampleRate;
+    int deviceBufferFrames;
+    
+    // Helper method starting a single-frequency channel
+    int StartToneChannel(float frequency, int durationMs, int note);
+    
+    // Helper methods for the shared output device
+    bool OpenOutputDevice();
+    static void SDLCALL PostmixCallback(void* userdata, const SDL_AudioSpec* spec, float* buffer, int buflen);
+    void ReprepareChannels(int newSampleRate);
+    
     // Helper method for initiating fade-out
     void StartFadeOut(ActiveChannel* channel);
     
+    // Helper method for stopping whichever voice a channel owns
+    void StopChannelOutput(ActiveChannel* channel);
+    
     // Helper method for applying fade-out volume scaling
     float CalculateFadeOutVolume(uint64_t currentTime, uint64_t startFadeTime, uint64_t fadeDuration);
 
     // Sample storage
     std::map<std::string, std::vector<WaveComponent>> samples;
+    
+    // Waveform cache keyed by HashComponents; entries keep their components to check hits
+    std::unordered_map<uint64_t, CachedWave> waveCache;
+    std::list<uint64_t> waveCacheLru; // front is most recently used
+    size_t waveCacheBytes;
+    size_t waveCacheLimit;
+    mutable std::mutex cacheMutex;
+    
+    // Helper methods for the waveform cache
+    uint64_t HashComponents(const std::vector<WaveComponent>& components) const;
+    const std::vector<float>& GetCachedWave(const std::vector<WaveComponent>& components);
+    void EvictCachedWave(uint64_t key);
 };
 
 // Global mixer instance
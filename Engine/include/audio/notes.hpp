@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// MIDI note number (0..127), e.g. 60 = C4, 69 = A4
+using NoteId = uint8_t;
+
+// Tuning systems selectable for note frequency tables
+enum class TuningSystem {
+    EqualTemperament,
+    JustIntonation  // 5-limit ratios relative to C
+};
+
+namespace Notes {
+
+constexpr int NOTE_COUNT = 128;
+constexpr NoteId C4 = 60;
+constexpr NoteId A4 = 69;
+constexpr float DEFAULT_A4_FREQUENCY = 440.0f;
+
+using RatioTable = std::array<double, NOTE_COUNT>;
+using FrequencyTable = std::array<float, NOTE_COUNT>;
+
+// Ratio of every MIDI note to A4 in twelve-tone equal temperament
+constexpr RatioTable makeEqualTemperamentRatios() {
+    // 2^(k/12) for one octave by repeated multiplication, octaves are exact powers of two
+    constexpr double SEMITONE = 1.0594630943592952646;
+    std::array<double, 12> octave{};
+    octave[0] = 1.0;
+    for (int k = 1; k < 12; k++) {
+        octave[k] = octave[k - 1] * SEMITONE;
+    }
+
+    RatioTable ratios{};
+    for (int note = 0; note < NOTE_COUNT; note++) {
+        int offset = note - A4;
+        int octaves = offset >= 0 ? offset / 12 : -((-offset + 11) / 12);
+        double ratio = octave[offset - octaves * 12];
+        for (int i = 0; i < octaves; i++) ratio *= 2.0;
+        for (int i = 0; i > octaves; i--) ratio *= 0.5;
+        ratios[note] = ratio;
+    }
+    return ratios;
+}
+
+// Ratio of every MIDI note to A4 in just intonation with C as the tonic
+constexpr RatioTable makeJustIntonationRatios() {
+    constexpr double SCALE[12] = {
+        1.0, 16.0 / 15.0, 9.0 / 8.0, 6.0 / 5.0, 5.0 / 4.0, 4.0 / 3.0,
+        45.0 / 32.0, 3.0 / 2.0, 8.0 / 5.0, 5.0 / 3.0, 9.0 / 5.0, 15.0 / 8.0
+    };
+    constexpr double A4_FROM_C4 = SCALE[A4 - C4];
+
+    RatioTable ratios{};
+    for (int note = 0; note < NOTE_COUNT; note++) {
+        int offset = note - C4;
+        int octaves = offset >= 0 ? offset / 12 : -((-offset + 11) / 12);
+        double ratio = SCALE[offset - octaves * 12] / A4_FROM_C4;
+        for (int i = 0; i < octaves; i++) ratio *= 2.0;
+        for (int i = 0; i > octaves; i--) ratio *= 0.5;
+        ratios[note] = ratio;
+    }
+    return ratios;
+}
+
+constexpr FrequencyTable makeFrequencyTable(const RatioTable& ratios, double a4Frequency) {
+    FrequencyTable frequencies{};
+    for (int note = 0; note < NOTE_COUNT; note++) {
+        frequencies[note] = static_cast<float>(ratios[note] * a4Frequency);
+    }
+    return frequencies;
+}
+
+// Generated at compile time
+constexpr RatioTable EQUAL_TEMPERAMENT_RATIOS = makeEqualTemperamentRatios();
+constexpr RatioTable JUST_INTONATION_RATIOS = makeJustIntonationRatios();
+constexpr FrequencyTable EQUAL_TEMPERAMENT_440 = makeFrequencyTable(EQUAL_TEMPERAMENT_RATIOS, DEFAULT_A4_FREQUENCY);
+
+inline const RatioTable& ratiosFor(TuningSystem system) {
+    return system == TuningSystem::JustIntonation ? JUST_INTONATION_RATIOS : EQUAL_TEMPERAMENT_RATIOS;
+}
+
+// Note names, e.g. pitchClassName(61) == "C#", octaveOf(61) == 4
+constexpr std::string_view pitchClassName(NoteId note) {
+    constexpr std::string_view NAMES[12] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+    return NAMES[note % 12];
+}
+
+constexpr int octaveOf(NoteId note) {
+    return note / 12 - 1;
+}
+
+// Parse names like "C4", "F#3", "Bb-1"; returns -1 for invalid or out of range names
+constexpr int noteIdFromName(std::string_view name) {
+    if (name.empty()) return -1;
+
+    constexpr int LETTER_OFFSETS[7] = {9, 11, 0, 2, 4, 5, 7}; // A B C D E F G
+    char letter = name[0];
+    if (letter >= 'a' && letter <= 'g') letter = static_cast<char>(letter - 'a' + 'A');
+    if (letter < 'A' || letter > 'G') return -1;
+
+    int pitchClass = LETTER_OFFSETS[letter - 'A'];
+    size_t pos = 1;
+    if (pos < name.size() && name[pos] == '#') { pitchClass++; pos++; }
+    else if (pos < name.size() && name[pos] == 'b') { pitchClass--; pos++; }
+
+    bool negative = false;
+    if (pos < name.size() && name[pos] == '-') { negative = true; pos++; }
+    if (pos >= name.size()) return -1;
+
+    int octave = 0;
+    for (; pos < name.size(); pos++) {
+        if (name[pos] < '0' || name[pos] > '9') return -1;
+        octave = octave * 10 + (name[pos] - '0');
+    }
+    if (negative) octave = -octave;
+
+    int note = (octave + 1) * 12 + pitchClass;
+    return (note >= 0 && note < NOTE_COUNT) ? note : -1;
+}
+
+static_assert(noteIdFromName("A4") == A4, "A4 must be MIDI note 69");
+static_assert(noteIdFromName("C4") == C4, "C4 must be MIDI note 60");
+
+} // namespace Notes
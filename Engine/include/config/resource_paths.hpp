@@ -7,6 +7,7 @@ namespace Config {
     // Configuration files
     const std::string GRAPHICS_CONFIG_FILE = "resources/video_settings.txt";
     const std::string KEYBOARD_CONFIG_FILE = "resources/keyboard_config.txt";
+    const std::string COMBO_CONFIG_FILE = "resources/combo_config.txt";
     
     
     // Add more resource paths as needed
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <inputs/keyboard.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Keyboard {
+
+using ComboId = uint16_t;
+constexpr ComboId INVALID_COMBO = 0xFFFF;
+
+// A combo is a sequence of steps; each step is one action press or a chord of
+// actions pressed in any order within the chord window.
+struct ComboDefinition {
+    std::string name;
+    std::vector<std::vector<ActionId>> steps;
+    uint32_t stepWindowMs = 300;   // max time between consecutive steps
+    uint32_t chordWindowMs = 50;   // max time between the presses of one chord
+};
+
+// Matches combos and chords against the timestamped stream of action presses.
+//
+// Definitions are compiled into a single deterministic automaton (an
+// Aho-Corasick machine over action presses; chords expand to every press
+// order). Each press is one table lookup, independent of how many combos are
+// defined. Timing is only checked for the combos that end on that press.
+class ComboMatcher {
+public:
+    // Definition; compile() must run before matching (loadFromFile does both)
+    ComboId addCombo(const ComboDefinition& definition);
+    void clear();
+    void compile();
+
+    // Format, one combo per line:
+    //   ComboName StepWindowMs Step [Step...]      (Step = ACTION or ACTION+ACTION...)
+    //   CHORD_WINDOW Ms                            (applies to the following combos)
+    // Action names are registered with the input manager if they are new.
+    bool loadFromFile(const std::string& filePath, KeyboardManager& input);
+
+    // Feed presses from the input manager
+    void attach(KeyboardManager& input);
+    void onActionPressed(ActionId action, uint64_t timestampNs);
+
+    // Publish the combos completed since the last update; call once per frame
+    void update();
+
+    bool isComboTriggered(ComboId combo) const;
+    ComboId getComboId(const std::string& name) const;
+    void registerComboCallback(ComboId combo, std::function<void()> callback);
+
+private:
+    // One concrete press order of a combo
+    struct Pattern {
+        ComboId combo;
+        uint32_t firstLimit;   // index into patternLimits
+        uint16_t length;
+    };
+
+    static constexpr uint32_t MAX_PATTERNS_PER_COMBO = 64;  // press orders; combos with more are ignored with a warning
+    static constexpr size_t HISTORY_SIZE = 32; // power of two, longest pattern that can match
+
+    std::vector<ComboDefinition> combos;
+    std::vector<std::function<void()>> comboCallbacks;
+    std::unordered_map<std::string, ComboId> comboIds;
+
+    // Compiled automaton
+    std::vector<int32_t> actionSymbols;     // ActionId -> symbol, -1 if unused by any combo
+    size_t symbolCount = 0;
+    std::vector<uint32_t> transitions;      // state * symbolCount + symbol -> state
+    std::vector<uint32_t> outputStart;      // patterns completed in a state: outputs[outputStart[s], outputStart[s + 1])
+    std::vector<uint32_t> outputs;
+    std::vector<Pattern> patterns;
+    std::vector<uint64_t> patternLimits;    // max ns before each press after the first
+    bool compiled = false;
+
+    // Matching state
+    uint32_t state = 0;
+    uint64_t history[HISTORY_SIZE] = {};    // timestamps of the latest presses
+    size_t historyCount = 0;
+    std::vector<ComboId> pending;           // completed since the last update
+    std::vector<ComboId> triggered;         // completed during the last frame
+};
+
+// Global instance, fed by Keyboard::Input
+extern ComboMatcher Combos;
+
+} // namespace Keyboard
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// One recorded input event, stored as-is in the binary file (32 bytes)
+struct RecordedInputEvent {
+    uint64_t timeNs;    // since the start of the recording
+    uint64_t frame;     // frame index relative to the start of the recording
+    uint32_t type;      // SDL_EventType
+    uint32_t code;      // scancode, mouse button, gamepad button or gamepad axis
+    int32_t value;      // keycode for keys, position for gamepad axes
+    uint16_t mod;       // keys only
+    uint8_t down;       // keys and buttons
+    uint8_t repeat;     // keys only
+};
+static_assert(sizeof(RecordedInputEvent) == 32, "RecordedInputEvent is part of the file format");
+
+// File header: magic, version and record size so stale files are rejected
+struct InputRecordingHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+enum class ReplayMode {
+    FrameLocked,  // deliver each event on the same frame it was recorded on
+    RealTime      // deliver each event once its recorded time has elapsed
+};
+
+// Writes the input events the app consumes to a compact binary file
+class InputRecorder {
+public:
+    ~InputRecorder();
+
+    bool start(const std::string& path, uint64_t currentFrame);
+    void stop();
+    bool isActive() const { return file.is_open(); }
+
+    // Record an event consumed on the given frame; unsupported types are ignored
+    void record(const SDL_Event& event, uint64_t currentFrame);
+
+    // Event types that are captured (and, QUIT aside, ignored from live input during replay)
+    static bool isRecordable(uint32_t eventType);
+
+private:
+    std::ofstream file;
+    std::string filePath;
+    uint64_t startNs = 0;
+    uint64_t startFrame = 0;
+    uint64_t eventCount = 0;
+};
+
+// Plays a recording back as SDL events, frame-locked or in real time
+class InputReplayer {
+public:
+    bool load(const std::string& path);
+    void start(uint64_t currentFrame, ReplayMode replayMode);
+    void stop();
+
+    bool isActive() const { return active; }
+    bool isFinished() const { return nextIndex >= events.size(); }
+    size_t getEventCount() const { return events.size(); }
+
+    // Next event due on this frame; call until it returns false
+    bool nextEvent(uint64_t currentFrame, SDL_Event& event);
+
+    static bool parseReplayMode(const std::string& value, ReplayMode& replayMode);
+
+private:
+    std::vector<RecordedInputEvent> events;
+    size_t nextIndex = 0;
+    ReplayMode mode = ReplayMode::FrameLocked;
+    uint64_t startNs = 0;
+    uint64_t startFrame = 0;
+    bool active = false;
+};
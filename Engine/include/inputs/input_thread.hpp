@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Single-producer/single-consumer ring of events. The producer is the thread
+// that pumps SDL events (or feeds a replay), the consumer is the input thread.
+class InputEventQueue {
+public:
+    static constexpr size_t CAPACITY = 256; // power of two
+
+    bool push(const SDL_Event& event);
+    bool pop(SDL_Event& event);
+
+private:
+    std::array<SDL_Event, CAPACITY> events;
+    alignas(64) std::atomic<size_t> head{0}; // next slot to read (consumer)
+    alignas(64) std::atomic<size_t> tail{0}; // next slot to write (producer)
+};
+
+// Delivers key events to latency-critical listeners (piano, audio) as soon as
+// SDL pumps them, instead of once per frame from App::processEvents.
+//
+// SDL only lets the video thread pump OS events, so pumping stays on the main
+// thread; an event watch hands each key event to this thread as soon as the
+// pump sees it, with the SDL arrival timestamp (event.common.timestamp, ns)
+// intact. The main thread pumps at the start of each frame and every
+// millisecond while the frame limiter idles, so an event waits at most for the
+// busy part of a frame (a whole frame with maxFPS 0, where nothing idles).
+// Frame-based consumers keep reading the per-frame snapshot in
+// Keyboard::Input, which is still fed from the main loop.
+class InputThread {
+public:
+    using Listener = std::function<void(const SDL_Event&)>;
+
+    ~InputThread();
+
+    // Listeners are called on the input thread; register them before start()
+    void addListener(Listener listener);
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    // Hand an event to the listeners; used for events that never pass through
+    // the SDL queue (replays). Runs them inline if the thread is not running.
+    void submit(const SDL_Event& event);
+
+    // Ignore live events from the SDL queue (while a replay drives input)
+    void setLiveInputEnabled(bool enabled) { liveInput.store(enabled, std::memory_order_release); }
+
+    // Events dropped because the queue was full
+    uint64_t getDroppedCount() const { return droppedEvents.load(std::memory_order_relaxed); }
+    // Worst time from SDL timestamp to listener dispatch so far
+    uint64_t getMaxDispatchLatencyNs() const { return maxDispatchLatencyNs.load(std::memory_order_relaxed); }
+
+    static bool isLatencyCritical(uint32_t eventType);
+
+private:
+    static bool SDLCALL EventWatch(void* userdata, SDL_Event* event);
+    void threadMain();
+    void dispatch(const SDL_Event& event);
+
+    InputEventQueue queue;
+    std::vector<Listener> listeners;
+    std::thread thread;
+    SDL_Semaphore* wakeup = nullptr;
+    std::atomic<bool> running{false};
+    std::atomic<bool> liveInput{true};
+    std::atomic<uint64_t> droppedEvents{0};
+    std::atomic<uint64_t> maxDispatchLatencyNs{0};
+};
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <SDL3/SDL_keycode.h>
+#include <SDL3/SDL_scancode.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Keyboard {
+
+struct KeyName {
+    std::string_view name;
+    SDL_Keycode keycode;
+};
+
+namespace KeyNames {
+
+// Every SDL keycode, named after its SDLK_ constant without the prefix
+// (SDLK_LSHIFT -> "LSHIFT"), in SDL_keycode.h order
+constexpr KeyName ALL[] = {
+    {"UNKNOWN", SDLK_UNKNOWN},
+    {"RETURN", SDLK_RETURN},
+    {"ESCAPE", SDLK_ESCAPE},
+    {"BACKSPACE", SDLK_BACKSPACE},
+    {"TAB", SDLK_TAB},
+    {"SPACE", SDLK_SPACE},
+    {"EXCLAIM", SDLK_EXCLAIM},
+    {"DBLAPOSTROPHE", SDLK_DBLAPOSTROPHE},
+    {"HASH", SDLK_HASH},
+    {"DOLLAR", SDLK_DOLLAR},
+    {"PERCENT", SDLK_PERCENT},
+    {"AMPERSAND", SDLK_AMPERSAND},
+    {"APOSTROPHE", SDLK_APOSTROPHE},
+    {"LEFTPAREN", SDLK_LEFTPAREN},
+    {"RIGHTPAREN", SDLK_RIGHTPAREN},
+    {"ASTERISK", SDLK_ASTERISK},
+    {"PLUS", SDLK_PLUS},
+    {"COMMA", SDLK_COMMA},
+    {"MINUS", SDLK_MINUS},
+    {"PERIOD", SDLK_PERIOD},
+    {"SLASH", SDLK_SLASH},
+    {"0", SDLK_0},
+    {"1", SDLK_1},
+    {"2", SDLK_2},
+    {"3", SDLK_3},
+    {"4", SDLK_4},
+    {"5", SDLK_5},
+    {"6", SDLK_6},
+    {"7", SDLK_7},
+    {"8", SDLK_8},
+    {"9", SDLK_9},
+    {"COLON", SDLK_COLON},
+    {"SEMICOLON", SDLK_SEMICOLON},
+    {"LESS", SDLK_LESS},
+    {"EQUALS", SDLK_EQUALS},
+    {"GREATER", SDLK_GREATER},
+    {"QUESTION", SDLK_QUESTION},
+    {"AT", SDLK_AT},
+    {"LEFTBRACKET", SDLK_LEFTBRACKET},
+    {"BACKSLASH", SDLK_BACKSLASH},
+    {"RIGHTBRACKET", SDLK_RIGHTBRACKET},
+    {"CARET", SDLK_CARET},
+    {"UNDERSCORE", SDLK_UNDERSCORE},
+    {"GRAVE", SDLK_GRAVE},
+    {"A", SDLK_A},
+    {"B", SDLK_B},
+    {"C", SDLK_C},
+    {"D", SDLK_D},
+    {"E", SDLK_E},
+    {"F", SDLK_F},
+    {"G", SDLK_G},
+    {"H", SDLK_H},
+    {"I", SDLK_I},
+    {"J", SDLK_J},
+    {"K", SDLK_K},
+    {"L", SDLK_L},
+    {"M", SDLK_M},
+    {"N", SDLK_N},
+    {"O", SDLK_O},
+    {"P", SDLK_P},
+    {"Q", SDLK_Q},
+    {"R", SDLK_R},
+    {"S", SDLK_S},
+    {"T", SDLK_T},
+    {"U", SDLK_U},
+    {"V", SDLK_V},
+    {"W", SDLK_W},
+    {"X", SDLK_X},
+    {"Y", SDLK_Y},
+    {"Z", SDLK_Z},
+    {"LEFTBRACE", SDLK_LEFTBRACE},
+    {"PIPE", SDLK_PIPE},
+    {"RIGHTBRACE", SDLK_RIGHTBRACE},
+    {"TILDE", SDLK_TILDE},
+    {"DELETE", SDLK_DELETE},
+    {"PLUSMINUS", SDLK_PLUSMINUS},
+    {"CAPSLOCK", SDLK_CAPSLOCK},
+    {"F1", SDLK_F1},
+    {"F2", SDLK_F2},
+    {"F3", SDLK_F3},
+    {"F4", SDLK_F4},
+    {"F5", SDLK_F5},
+    {"F6", SDLK_F6},
+    {"F7", SDLK_F7},
+    {"F8", SDLK_F8},
+    {"F9", SDLK_F9},
+    {"F10", SDLK_F10},
+    {"F11", SDLK_F11},
+    {"F12", SDLK_F12},
+    {"PRINTSCREEN", SDLK_PRINTSCREEN},
+    {"SCROLLLOCK", SDLK_SCROLLLOCK},
+    {"PAUSE", SDLK_PAUSE},
+    {"INSERT", SDLK_INSERT},
+    {"HOME", SDLK_HOME},
+    {"PAGEUP", SDLK_PAGEUP},
+    {"END", SDLK_END},
+    {"PAGEDOWN", SDLK_PAGEDOWN},
+    {"RIGHT", SDLK_RIGHT},
+    {"LEFT", SDLK_LEFT},
+    {"DOWN", SDLK_DOWN},
+    {"UP", SDLK_UP},
+    {"NUMLOCKCLEAR", SDLK_NUMLOCKCLEAR},
+    {"KP_DIVIDE", SDLK_KP_DIVIDE},
+    {"KP_MULTIPLY", SDLK_KP_MULTIPLY},
+    {"KP_MINUS", SDLK_KP_MINUS},
+    {"KP_PLUS", SDLK_KP_PLUS},
+    {"KP_ENTER", SDLK_KP_ENTER},
+    {"KP_1", SDLK_KP_1},
+    {"KP_2", SDLK_KP_2},
+    {"KP_3", SDLK_KP_3},
+    {"KP_4", SDLK_KP_4},
+    {"KP_5", SDLK_KP_5},
+    {"KP_6", SDLK_KP_6},
+    {"KP_7", SDLK_KP_7},
+    {"KP_8", SDLK_KP_8},
+    {"KP_9", SDLK_KP_9},
+    {"KP_0", SDLK_KP_0},
+    {"KP_PERIOD", SDLK_KP_PERIOD},
+    {"APPLICATION", SDLK_APPLICATION},
+    {"POWER", SDLK_POWER},
+    {"KP_EQUALS", SDLK_KP_EQUALS},
+    {"F13", SDLK_F13},
+    {"F14", SDLK_F14},
+    {"F15", SDLK_F15},
+    {"F16", SDLK_F16},
+    {"F17", SDLK_F17},
+    {"F18", SDLK_F18},
+    {"F19", SDLK_F19},
+    {"F20", SDLK_F20},
+    {"F21", SDLK_F21},
+    {"F22", SDLK_F22},
+    {"F23", SDLK_F23},
+    {"F24", SDLK_F24},
+    {"EXECUTE", SDLK_EXECUTE},
+    {"HELP", SDLK_HELP},
+    {"MENU", SDLK_MENU},
+    {"SELECT", SDLK_SELECT},
+    {"STOP", SDLK_STOP},
+    {"AGAIN", SDLK_AGAIN},
+    {"UNDO", SDLK_UNDO},
+    {"CUT", SDLK_CUT},
+    {"COPY", SDLK_COPY},
+    {"PASTE", SDLK_PASTE},
+    {"FIND", SDLK_FIND},
+    {"MUTE", SDLK_MUTE},
+    {"VOLUMEUP", SDLK_VOLUMEUP},
+    {"VOLUMEDOWN", SDLK_VOLUMEDOWN},
+    {"KP_COMMA", SDLK_KP_COMMA},
+    {"KP_EQUALSAS400", SDLK_KP_EQUALSAS400},
+    {"ALTERASE", SDLK_ALTERASE},
+    {"SYSREQ", SDLK_SYSREQ},
+    {"CANCEL", SDLK_CANCEL},
+    {"CLEAR", SDLK_CLEAR},
+    {"PRIOR", SDLK_PRIOR},
+    {"RETURN2", SDLK_RETURN2},
+    {"SEPARATOR", SDLK_SEPARATOR},
+    {"OUT", SDLK_OUT},
+    {"OPER", SDLK_OPER},
+    {"CLEARAGAIN", SDLK_CLEARAGAIN},
+    {"CRSEL", SDLK_CRSEL},
+    {"EXSEL", SDLK_EXSEL},
+    {"KP_00", SDLK_KP_00},
+    {"KP_000", SDLK_KP_000},
+    {"THOUSANDSSEPARATOR", SDLK_THOUSANDSSEPARATOR},
+    {"DECIMALSEPARATOR", SDLK_DECIMALSEPARATOR},
+    {"CURRENCYUNIT", SDLK_CURRENCYUNIT},
+    {"CURRENCYSUBUNIT", SDLK_CURRENCYSUBUNIT},
+    {"KP_LEFTPAREN", SDLK_KP_LEFTPAREN},
+    {"KP_RIGHTPAREN", SDLK_KP_RIGHTPAREN},
+    {"KP_LEFTBRACE", SDLK_KP_LEFTBRACE},
+    {"KP_RIGHTBRACE", SDLK_KP_RIGHTBRACE},
+    {"KP_TAB", SDLK_KP_TAB},
+    {"KP_BACKSPACE", SDLK_KP_BACKSPACE},
+    {"KP_A", SDLK_KP_A},
+    {"KP_B", SDLK_KP_B},
+    {"KP_C", SDLK_KP_C},
+    {"KP_D", SDLK_KP_D},
+    {"KP_E", SDLK_KP_E},
+    {"KP_F", SDLK_KP_F},
+    {"KP_XOR", SDLK_KP_XOR},
+    {"KP_POWER", SDLK_KP_POWER},
+    {"KP_PERCENT", SDLK_KP_PERCENT},
+    {"KP_LESS", SDLK_KP_LESS},
+    {"KP_GREATER", SDLK_KP_GREATER},
+    {"KP_AMPERSAND", SDLK_KP_AMPERSAND},
+    {"KP_DBLAMPERSAND", SDLK_KP_DBLAMPERSAND},
+    {"KP_VERTICALBAR", SDLK_KP_VERTICALBAR},
+    {"KP_DBLVERTICALBAR", SDLK_KP_DBLVERTICALBAR},
+    {"KP_COLON", SDLK_KP_COLON},
+    {"KP_HASH", SDLK_KP_HASH},
+    {"KP_SPACE", SDLK_KP_SPACE},
+    {"KP_AT", SDLK_KP_AT},
+    {"KP_EXCLAM", SDLK_KP_EXCLAM},
+    {"KP_MEMSTORE", SDLK_KP_MEMSTORE},
+    {"KP_MEMRECALL", SDLK_KP_MEMRECALL},
+    {"KP_MEMCLEAR", SDLK_KP_MEMCLEAR},
+    {"KP_MEMADD", SDLK_KP_MEMADD},
+    {"KP_MEMSUBTRACT", SDLK_KP_MEMSUBTRACT},
+    {"KP_MEMMULTIPLY", SDLK_KP_MEMMULTIPLY},
+    {"KP_MEMDIVIDE", SDLK_KP_MEMDIVIDE},
+    {"KP_PLUSMINUS", SDLK_KP_PLUSMINUS},
+    {"KP_CLEAR", SDLK_KP_CLEAR},
+    {"KP_CLEARENTRY", SDLK_KP_CLEARENTRY},
+    {"KP_BINARY", SDLK_KP_BINARY},
+    {"KP_OCTAL", SDLK_KP_OCTAL},
+    {"KP_DECIMAL", SDLK_KP_DECIMAL},
+    {"KP_HEXADECIMAL", SDLK_KP_HEXADECIMAL},
+    {"LCTRL", SDLK_LCTRL},
+    {"LSHIFT", SDLK_LSHIFT},
+    {"LALT", SDLK_LALT},
+    {"LGUI", SDLK_LGUI},
+    {"RCTRL", SDLK_RCTRL},
+    {"RSHIFT", SDLK_RSHIFT},
+    {"RALT", SDLK_RALT},
+    {"RGUI", SDLK_RGUI},
+    {"MODE", SDLK_MODE},
+    {"SLEEP", SDLK_SLEEP},
+    {"WAKE", SDLK_WAKE},
+    {"CHANNEL_INCREMENT", SDLK_CHANNEL_INCREMENT},
+    {"CHANNEL_DECREMENT", SDLK_CHANNEL_DECREMENT},
+    {"MEDIA_PLAY", SDLK_MEDIA_PLAY},
+    {"MEDIA_PAUSE", SDLK_MEDIA_PAUSE},
+    {"MEDIA_RECORD", SDLK_MEDIA_RECORD},
+    {"MEDIA_FAST_FORWARD", SDLK_MEDIA_FAST_FORWARD},
+    {"MEDIA_REWIND", SDLK_MEDIA_REWIND},
+    {"MEDIA_NEXT_TRACK", SDLK_MEDIA_NEXT_TRACK},
+    {"MEDIA_PREVIOUS_TRACK", SDLK_MEDIA_PREVIOUS_TRACK},
+    {"MEDIA_STOP", SDLK_MEDIA_STOP},
+    {"MEDIA_EJECT", SDLK_MEDIA_EJECT},
+    {"MEDIA_PLAY_PAUSE", SDLK_MEDIA_PLAY_PAUSE},
+    {"MEDIA_SELECT", SDLK_MEDIA_SELECT},
+    {"AC_NEW", SDLK_AC_NEW},
+    {"AC_OPEN", SDLK_AC_OPEN},
+    {"AC_CLOSE", SDLK_AC_CLOSE},
+    {"AC_EXIT", SDLK_AC_EXIT},
+    {"AC_SAVE", SDLK_AC_SAVE},
+    {"AC_PRINT", SDLK_AC_PRINT},
+    {"AC_PROPERTIES", SDLK_AC_PROPERTIES},
+    {"AC_SEARCH", SDLK_AC_SEARCH},
+    {"AC_HOME", SDLK_AC_HOME},
+    {"AC_BACK", SDLK_AC_BACK},
+    {"AC_FORWARD", SDLK_AC_FORWARD},
+    {"AC_STOP", SDLK_AC_STOP},
+    {"AC_REFRESH", SDLK_AC_REFRESH},
+    {"AC_BOOKMARKS", SDLK_AC_BOOKMARKS},
+    {"SOFTLEFT", SDLK_SOFTLEFT},
+    {"SOFTRIGHT", SDLK_SOFTRIGHT},
+    {"CALL", SDLK_CALL},
+    {"ENDCALL", SDLK_ENDCALL},
+    {"LEFT_TAB", SDLK_LEFT_TAB},
+    {"LEVEL5_SHIFT", SDLK_LEVEL5_SHIFT},
+    {"MULTI_KEY_COMPOSE", SDLK_MULTI_KEY_COMPOSE},
+    {"LMETA", SDLK_LMETA},
+    {"RMETA", SDLK_RMETA},
+    {"LHYPER", SDLK_LHYPER},
+    {"RHYPER", SDLK_RHYPER},
+};
+constexpr size_t COUNT = sizeof(ALL) / sizeof(ALL[0]);
+
+using Table = std::array<KeyName, COUNT>;
+
+// Insertion sort, run once at compile time
+template <typename Less>
+constexpr Table sortedBy(Less less) {
+    Table table{};
+    for (size_t i = 0; i < COUNT; i++) {
+        size_t j = i;
+        while (j > 0 && less(ALL[i], table[j - 1])) {
+            table[j] = table[j - 1];
+            j--;
+        }
+        table[j] = ALL[i];
+    }
+    return table;
+}
+
+constexpr Table BY_NAME = sortedBy([](const KeyName& a, const KeyName& b) { return a.name < b.name; });
+constexpr Table BY_KEYCODE = sortedBy([](const KeyName& a, const KeyName& b) { return a.keycode < b.keycode; });
+
+// Binary searches over the sorted tables; no allocation, usable in constant expressions
+constexpr SDL_Keycode fromName(std::string_view name) {
+    size_t low = 0, high = COUNT;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (BY_NAME[mid].name < name) low = mid + 1;
+        else high = mid;
+    }
+    return (low < COUNT && BY_NAME[low].name == name) ? BY_NAME[low].keycode : SDLK_UNKNOWN;
+}
+
+// Direct slots for character keycodes (< 128) and scancode-based keycodes
+// (SDLK_SCANCODE_MASK | scancode), which cover all but the few extended keys
+constexpr size_t ASCII_SLOTS = 128;
+constexpr size_t SLOT_COUNT = ASCII_SLOTS + SDL_SCANCODE_COUNT;
+constexpr uint16_t NO_SLOT = 0xFFFF;
+
+constexpr size_t slotOf(SDL_Keycode keycode) {
+    if (keycode < ASCII_SLOTS) return keycode;
+    if ((keycode & SDLK_SCANCODE_MASK) && (keycode & ~SDLK_SCANCODE_MASK) < SDL_SCANCODE_COUNT) {
+        return ASCII_SLOTS + (keycode & ~SDLK_SCANCODE_MASK);
+    }
+    return SLOT_COUNT;
+}
+
+constexpr std::array<uint16_t, SLOT_COUNT> makeSlots() {
+    std::array<uint16_t, SLOT_COUNT> slots{};
+    for (auto& slot : slots) slot = NO_SLOT;
+    for (size_t i = 0; i < COUNT; i++) {
+        size_t slot = slotOf(ALL[i].keycode);
+        if (slot < SLOT_COUNT) slots[slot] = static_cast<uint16_t>(i);
+    }
+    return slots;
+}
+
+constexpr std::array<uint16_t, SLOT_COUNT> SLOTS = makeSlots();
+
+constexpr std::string_view toName(SDL_Keycode keycode) {
+    size_t slot = slotOf(keycode);
+    if (slot < SLOT_COUNT) {
+        return SLOTS[slot] != NO_SLOT ? ALL[SLOTS[slot]].name : std::string_view("UNKNOWN");
+    }
+
+    // Extended keycodes
+    size_t low = 0, high = COUNT;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (BY_KEYCODE[mid].keycode < keycode) low = mid + 1;
+        else high = mid;
+    }
+    return (low < COUNT && BY_KEYCODE[low].keycode == keycode) ? BY_KEYCODE[low].name : std::string_view("UNKNOWN");
+}
+
+static_assert(fromName("SPACE") == SDLK_SPACE && fromName("LSHIFT") == SDLK_LSHIFT, "Key name table is out of order");
+static_assert(toName(SDLK_F12) == "F12" && toName(SDLK_LEFT_TAB) == "LEFT_TAB" && toName(SDLK_UNKNOWN) == "UNKNOWN",
+              "Keycode table is out of order");
+
+} // namespace KeyNames
+
+} // namespace Keyboard
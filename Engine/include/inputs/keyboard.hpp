@@ -5,7 +5,10 @@
 #include <SDL3/SDL_vulkan.h>
 #include <SDL3/SDL_events.h>
 #include <unordered_map>
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <functional>
 #include <vector>
 #include <fstream>
@@ -20,10 +23,89 @@ enum class KeyState {
     JUST_RELEASED
 };
 
+// Verbose input logging, off in steady state. Builds with KEYBOARD_TRACE=0
+// (the default for production builds) compile the tracing out entirely.
+enum class TraceLevel {
+    Off,
+    Edges,  // log key presses and releases
+    Held    // additionally log every held key, every frame
+};
+
+// Fixed-size bit set with one bit per SDL_Scancode
+struct KeyBits {
+    static constexpr size_t WORD_COUNT = (SDL_SCANCODE_COUNT + 63) / 64;
+    uint64_t words[WORD_COUNT] = {};
+    
+    // Scancodes are masked into range so lookups never branch
+    bool test(SDL_Scancode scancode) const {
+        size_t index = static_cast<size_t>(scancode) & (SDL_SCANCODE_COUNT - 1);
+        return (words[index >> 6] >> (index & 63)) & 1u;
+    }
+    void set(SDL_Scancode scancode) {
+        size_t index = static_cast<size_t>(scancode) & (SDL_SCANCODE_COUNT - 1);
+        words[index >> 6] |= uint64_t(1) << (index & 63);
+    }
+    void reset(SDL_Scancode scancode) {
+        size_t index = static_cast<size_t>(scancode) & (SDL_SCANCODE_COUNT - 1);
+        words[index >> 6] &= ~(uint64_t(1) << (index & 63));
+    }
+    void clear() {
+        for (auto& word : words) word = 0;
+    }
+};
+static_assert((SDL_SCANCODE_COUNT & (SDL_SCANCODE_COUNT - 1)) == 0, "KeyBits masking needs a power-of-two scancode count");
+
+// Dense action handle handed out when an action is registered
+using ActionId = uint16_t;
+constexpr ActionId INVALID_ACTION = 0xFFFF;
+
+// Growable bit set with one bit per ActionId
+struct ActionBits {
+    std::vector<uint64_t> words;
+    
+    void resize(size_t count) { words.resize((count + 63) / 64, 0); }
+    bool test(ActionId id) const {
+        size_t word = id >> 6;
+        return word < words.size() && ((words[word] >> (id & 63)) & 1u);
+    }
+    void set(ActionId id) { words[id >> 6] |= uint64_t(1) << (id & 63); }
+    void clear() {
+        for (auto& word : words) word = 0;
+    }
+};
+
+// Devices an action can be bound to
+enum class InputSource : uint8_t {
+    Key,            // code is an SDL_Keycode
+    MouseButton,    // code is an SDL mouse button (SDL_BUTTON_LEFT, ...)
+    GamepadButton,  // code is an SDL_GamepadButton
+    GamepadAxis     // code is an SDL_GamepadAxis, one direction per binding
+};
+
+struct InputBinding {
+    InputSource source = InputSource::Key;
+    int32_t code = 0;
+    bool negative = false;  // axis bindings respond to the negative half of the axis
+    float deadzone = 0.0f;  // axis values inside the deadzone read as 0
+};
+
+// Mouse buttons, gamepad buttons and gamepad half-axes share one small table
+// of analog control values (0..1) so they can be tracked in a single word
+namespace Controls {
+    constexpr int MOUSE_BUTTON_COUNT = 8;
+    constexpr int MOUSE_BASE = 0;
+    constexpr int GAMEPAD_BUTTON_BASE = MOUSE_BASE + MOUSE_BUTTON_COUNT;
+    constexpr int GAMEPAD_AXIS_BASE = GAMEPAD_BUTTON_BASE + SDL_GAMEPAD_BUTTON_COUNT;
+    constexpr int COUNT = GAMEPAD_AXIS_BASE + SDL_GAMEPAD_AXIS_COUNT * 2;
+    static_assert(COUNT <= 64, "Control bits must fit in one word");
+    
+    constexpr float DEFAULT_AXIS_DEADZONE = 0.2f;
+    constexpr float PRESS_THRESHOLD = 0.5f;  // analog value at which an action counts as pressed
+}
+
 struct ActionMapping {
     std::string actionName;
-    SDL_Keycode primaryKey;
-    SDL_Keycode alternateKey;
+    std::vector<InputBinding> bindings;
     std::function<void()> pressCallback;
     std::function<void()> releaseCallback;
     std::function<void()> holdCallback;
@@ -31,10 +113,68 @@ struct ActionMapping {
 
 class KeyboardManager {
 private:
-    static constexpr size_t MAX_KEY_STATES = 0; // Maximum allowed key states
-    std::unordered_map<SDL_Keycode, KeyState> keyStates;
-    std::unordered_map<std::string, ActionMapping> actionMappings;
+    // Key state, double buffered per frame. Events update liveKeys as they arrive;
+    // update() snapshots them into currentKeys and derives the edges with bit ops.
+    KeyBits liveKeys;
+    KeyBits currentKeys;
+    KeyBits previousKeys;
+    KeyBits pressedEvents;   // went down since the last update (keeps taps shorter than a frame)
+    KeyBits releasedEvents;  // went up since the last update
+    KeyBits justPressedKeys;
+    KeyBits justReleasedKeys;
+    
+    // Keycode <-> scancode translation, refreshed from incoming events
+    std::array<SDL_Scancode, 128> asciiScancodes;
+    std::array<SDL_Keycode, SDL_SCANCODE_COUNT> scancodeKeycodes;
+    
+    // Actions indexed by ActionId; names are interned once into actionIds and
+    // ids stay valid across configuration reloads
+    std::vector<ActionMapping> actionMappings;
+    std::unordered_map<std::string, ActionId> actionIds;
+    
+    // Mouse and gamepad control state, indexed by controlIndex()
+    std::array<float, Controls::COUNT> controlValues{};
+    uint64_t activeControls = 0;        // controls with a non-zero value
+    uint64_t controlPressEvents = 0;    // went down since the last update
+    uint64_t tappedControls = 0;        // went down and back up since the last update
+    std::vector<SDL_Gamepad*> gamepads;
+    
+    // Reverse indices from a bound key or control to its actions, rebuilt
+    // lazily after bindings change so events and updates only visit the
+    // affected actions
+    struct ControlBinding {
+        ActionId action;
+        float deadzone;
+    };
+    std::unordered_map<SDL_Keycode, std::vector<ActionId>> keyActions;
+    std::array<std::vector<ControlBinding>, Controls::COUNT> controlActions;
+    bool keyActionsDirty = false;
+    
+    // Action state, evaluated once per frame in update() into parallel arrays:
+    // one analog value and one bit per state for every ActionId
+    std::vector<float> actionValues;
+    std::vector<ActionId> valuedActions;  // actions with a non-zero value this frame
+    ActionBits actionPressed;
+    ActionBits actionPreviousPressed;
+    ActionBits actionJustPressed;
+    ActionBits actionJustReleased;
+    
     std::string configFilePath;
+    TraceLevel traceLevel = TraceLevel::Off;
+    
+    // Called with the SDL timestamp (ns) of every action press, as it happens
+    using ActionPressListener = std::function<void(ActionId, uint64_t)>;
+    std::vector<ActionPressListener> actionPressListeners;
+    
+    void rebuildKeyActions();
+    const std::vector<ActionId>* actionsForKey(SDL_Keycode key);
+    const std::vector<ControlBinding>& actionsForControl(int control);
+    void setControlValue(int control, float value, uint64_t timestampNs);
+    void releaseGamepadControls(uint64_t timestampNs);
+    void notifyActionPressed(ActionId action, uint64_t timestampNs);
+    void accumulateAction(ActionId action, float value);
+    void updateActionStates();
+    void traceFrame() const;
 
 public:
     KeyboardManager(const std::string& configFile = "resources/keyboard_config.txt");
@@ -47,27 +187,77 @@ public:
     void handleEvent(const SDL_Event& event);
     void update(); // Call each frame to update JUST_PRESSED -> PRESSED, JUST_RELEASED -> RELEASED
     
-    // Direct key state checking
-    KeyState getKeyState(SDL_Keycode keyCode) const;
-    bool isKeyPressed(SDL_Keycode keyCode) const;
-    bool isKeyJustPressed(SDL_Keycode keyCode) const;
-    bool isKeyJustReleased(SDL_Keycode keyCode) const;
+    // Direct key state checking by scancode (single bit test)
+    KeyState getKeyState(SDL_Scancode scancode) const;
+    bool isKeyPressed(SDL_Scancode scancode) const { return currentKeys.test(scancode); }
+    bool isKeyJustPressed(SDL_Scancode scancode) const { return justPressedKeys.test(scancode); }
+    bool isKeyJustReleased(SDL_Scancode scancode) const { return justReleasedKeys.test(scancode); }
+    
+    // Direct key state checking by keycode (translated to a scancode first)
+    KeyState getKeyState(SDL_Keycode keyCode) const { return getKeyState(toScancode(keyCode)); }
+    bool isKeyPressed(SDL_Keycode keyCode) const { return isKeyPressed(toScancode(keyCode)); }
+    bool isKeyJustPressed(SDL_Keycode keyCode) const { return isKeyJustPressed(toScancode(keyCode)); }
+    bool isKeyJustReleased(SDL_Keycode keyCode) const { return isKeyJustReleased(toScancode(keyCode)); }
+    
+    // Non-character keycodes embed their scancode; ASCII keys use a table
+    SDL_Scancode toScancode(SDL_Keycode keyCode) const {
+        if (keyCode & SDLK_SCANCODE_MASK) {
+            return static_cast<SDL_Scancode>(keyCode & ~SDLK_SCANCODE_MASK);
+        }
+        if (keyCode < asciiScancodes.size()) {
+            return asciiScancodes[keyCode];
+        }
+        return SDL_GetScancodeFromKey(keyCode, nullptr);
+    }
+    
+    // Action registration: names are resolved to ids once, at load time.
+    // mapAction replaces an action's key bindings, bindAction adds any binding.
+    ActionId mapAction(const std::string& actionName, SDL_Keycode primaryKey, SDL_Keycode alternateKey = SDLK_UNKNOWN);
+    ActionId bindAction(const std::string& actionName, const InputBinding& binding);
+    ActionId registerAction(const std::string& actionName);
+    ActionId getActionId(const std::string& actionName) const;
     
-    // Action-based interface
-    bool mapAction(const std::string& actionName, SDL_Keycode primaryKey, SDL_Keycode alternateKey = SDLK_UNKNOWN);
+    // Analog action value (0..1), the strongest of the action's bindings
+    float getActionValue(ActionId action) const { return action < actionValues.size() ? actionValues[action] : 0.0f; }
+    
+    // Action queries by id (single bit test on the per-frame state)
+    bool isActionPressed(ActionId action) const { return actionPressed.test(action); }
+    bool isActionJustPressed(ActionId action) const { return actionJustPressed.test(action); }
+    bool isActionJustReleased(ActionId action) const { return actionJustReleased.test(action); }
+    
+    // Action queries by name (hash lookup per call, prefer ids on hot paths)
     bool isActionPressed(const std::string& actionName) const;
     bool isActionJustPressed(const std::string& actionName) const;
     bool isActionJustReleased(const std::string& actionName) const;
     
+    // Timestamped stream of action presses (used by the combo matcher)
+    void addActionPressListener(std::function<void(ActionId, uint64_t)> listener);
+    
     // Callback registration
+    void registerActionCallback(ActionId action,
+                               std::function<void()> pressCallback = nullptr,
+                               std::function<void()> releaseCallback = nullptr,
+                               std::function<void()> holdCallback = nullptr);
     void registerActionCallback(const std::string& actionName, 
                                std::function<void()> pressCallback = nullptr,
                                std::function<void()> releaseCallback = nullptr,
                                std::function<void()> holdCallback = nullptr);
                                
-    // Helper function to convert string to SDL_Keycode
-    static SDL_Keycode stringToKeycode(const std::string& keyName);
-    static std::string keycodeToString(SDL_Keycode keycode);
+    // Runtime trace level (no effect when tracing is compiled out)
+    void setTraceLevel(TraceLevel level) { traceLevel = level; }
+    TraceLevel getTraceLevel() const { return traceLevel; }
+    static TraceLevel parseTraceLevel(const std::string& value);
+    
+    // Bindings as written in the configuration file: key names (SPACE, W),
+    // MOUSE_LEFT/RIGHT/MIDDLE/X1/X2, PAD:<button> and AXIS:<axis>+|-[@deadzone]
+    static bool parseBinding(const std::string& token, InputBinding& binding);
+    static std::string bindingToString(const InputBinding& binding);
+    static int controlIndex(const InputBinding& binding); // -1 for key bindings
+    
+    // Key names are the SDLK_ constant without its prefix ("SPACE", "LSHIFT",
+    // "KP_ENTER"); see inputs/key_names.hpp for the full table
+    static SDL_Keycode stringToKeycode(std::string_view keyName);
+    static std::string_view keycodeToString(SDL_Keycode keycode);
 };
 
 // Global instance
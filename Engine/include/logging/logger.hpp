@@ -0,0 +1,218 @@
+#pragma once
+
+#include <profiling/profiler.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Asynchronous logging. A log call copies its arguments, binary-encoded, into
+// a lock-free ring owned by the calling thread; a background writer drains
+// the rings, formats the records in timestamp order and writes them to the
+// console (and as JSON lines to logFile, when set). A full ring drops the
+// record instead of blocking. Before Log::start and after Log::stop records
+// are written synchronously.
+//
+//     LOG_INFO(Log::Category::Audio, "Playing note {}{} ({} Hz)", name, octave, frequency);
+//
+// Formats use {} placeholders and must be string literals. Levels below
+// LOG_MIN_LEVEL and categories outside LOG_CATEGORY_MASK compile to nothing;
+// the rest are filtered at runtime by logLevel and logCategories.
+namespace Log {
+
+enum class Level : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+enum class Category : uint8_t {
+    General,
+    Audio,
+    Input,
+    Renderer,
+    Count
+};
+
+} // namespace Log
+
+#ifndef LOG_MIN_LEVEL
+#if PRODUCTION_BUILD
+#define LOG_MIN_LEVEL 1 // Info
+#else
+#define LOG_MIN_LEVEL 0 // Debug
+#endif
+#endif
+
+#ifndef LOG_CATEGORY_MASK
+#define LOG_CATEGORY_MASK 0xFFFFFFFFu
+#endif
+
+namespace Log {
+
+// Where a log call is; one static instance per call site
+struct Site {
+    Level level;
+    Category category;
+    const char* format;
+};
+
+enum class ArgType : uint8_t {
+    Int,
+    UInt,
+    Double,
+    Bool,
+    Char,
+    String
+};
+
+// One log call. Fixed size, so the rings never allocate; strings that don't
+// fit are cut short.
+struct Record {
+    static constexpr size_t SIZE = 128;
+    static constexpr size_t ARG_BYTES = SIZE - 20;
+
+    uint64_t ticks;             // readProfileTicks(); the writer converts them
+    const Site* site;
+    uint16_t argBytes;
+    uint8_t argCount;
+    bool truncated;
+    unsigned char args[ARG_BYTES];
+};
+static_assert(sizeof(Record) == Record::SIZE, "Records are meant to be exactly SIZE bytes");
+
+constexpr bool compiledIn(Level level, Category category) {
+#if LOG_MIN_LEVEL > 0
+    // Only compared when it can fail; level >= 0 warns as always true
+    if (static_cast<int>(level) < LOG_MIN_LEVEL) {
+        return false;
+    }
+#else
+    (void)level;
+#endif
+    return ((LOG_CATEGORY_MASK >> static_cast<uint32_t>(category)) & 1u) != 0;
+}
+
+namespace Detail {
+    extern std::atomic<uint8_t> minLevel;
+    extern std::atomic<uint32_t> categoryMask;
+
+    // The calling thread's next free record, nullptr when its ring is full
+    Record* beginRecord();
+    void commitRecord(Record* record);
+
+    inline void putBytes(Record& record, const void* data, size_t size) {
+        std::memcpy(record.args + record.argBytes, data, size);
+        record.argBytes = static_cast<uint16_t>(record.argBytes + size);
+    }
+
+    template <typename T>
+    void putValue(Record& record, ArgType type, T value) {
+        if (record.argBytes + 1 + sizeof(T) > Record::ARG_BYTES) {
+            record.truncated = true;
+            return;
+        }
+        putBytes(record, &type, 1);
+        putBytes(record, &value, sizeof(T));
+        record.argCount++;
+    }
+
+    inline void putString(Record& record, std::string_view text) {
+        size_t header = 1 + sizeof(uint16_t);
+        if (record.argBytes + header > Record::ARG_BYTES) {
+            record.truncated = true;
+            return;
+        }
+        size_t room = Record::ARG_BYTES - record.argBytes - header;
+        uint16_t length = static_cast<uint16_t>(text.size() < room ? text.size() : room);
+        if (length < text.size()) {
+            record.truncated = true;
+        }
+        ArgType type = ArgType::String;
+        putBytes(record, &type, 1);
+        putBytes(record, &length, sizeof(length));
+        putBytes(record, text.data(), length);
+        record.argCount++;
+    }
+
+    template <typename T>
+    void encode(Record& record, const T& value) {
+        using Type = std::decay_t<T>;
+        if constexpr (std::is_same_v<Type, bool>) {
+            putValue<uint8_t>(record, ArgType::Bool, value ? 1 : 0);
+        } else if constexpr (std::is_same_v<Type, char>) {
+            putValue<char>(record, ArgType::Char, value);
+        } else if constexpr (std::is_enum_v<Type>) {
+            encode(record, static_cast<std::underlying_type_t<Type>>(value));
+        } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+            putValue<int64_t>(record, ArgType::Int, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<Type>) {
+            putValue<uint64_t>(record, ArgType::UInt, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<Type>) {
+            putValue<double>(record, ArgType::Double, static_cast<double>(value));
+        } else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+            putString(record, value ? std::string_view(value) : std::string_view("(null)"));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            putString(record, std::string_view(value));
+        } else {
+            static_assert(std::is_arithmetic_v<Type>, "Unsupported log argument type");
+        }
+    }
+}
+
+inline bool isEnabled(Level level, Category category) {
+    return static_cast<uint8_t>(level) >= Detail::minLevel.load(std::memory_order_relaxed) &&
+           ((Detail::categoryMask.load(std::memory_order_relaxed) >> static_cast<uint32_t>(category)) & 1u) != 0;
+}
+
+template <typename... Args>
+void write(const Site& site, const Args&... args) {
+    Record* record = Detail::beginRecord();
+    if (!record) {
+        return; // ring full, counted as dropped
+    }
+    record->ticks = readProfileTicks();
+    record->site = &site;
+    record->argBytes = 0;
+    record->argCount = 0;
+    record->truncated = false;
+    (Detail::encode(*record, args), ...);
+    Detail::commitRecord(record);
+}
+
+// Runtime filters
+void setLevel(Level level);
+void setCategories(uint32_t mask);
+// From the settings: level is "debug", "info", "warning" or "error";
+// categories is "all" or a comma-separated list. Unknown names are reported.
+void configure(const std::string& level, const std::string& categories);
+const char* levelName(Level level);
+const char* categoryName(Category category);
+
+// Start the writer thread; logFile (optional) also receives JSON lines. The
+// writer is stopped, and everything queued written out, at exit.
+void start(const std::string& logFile = "");
+void stop();
+
+// Records dropped because a thread's ring was full
+uint64_t getDroppedCount();
+
+} // namespace Log
+
+#define LOG_AT(level, category, format, ...)                                        \
+    do {                                                                            \
+        if constexpr (Log::compiledIn(level, category)) {                           \
+            if (Log::isEnabled(level, category)) {                                  \
+                static constexpr Log::Site logSite{level, category, format};        \
+                Log::write(logSite, ##__VA_ARGS__);                                 \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+#define LOG_DEBUG(category, format, ...) LOG_AT(Log::Level::Debug, category, format, ##__VA_ARGS__)
+#define LOG_INFO(category, format, ...) LOG_AT(Log::Level::Info, category, format, ##__VA_ARGS__)
+#define LOG_WARNING(category, format, ...) LOG_AT(Log::Level::Warning, category, format, ##__VA_ARGS__)
+#define LOG_ERROR(category, format, ...) LOG_AT(Log::Level::Error, category, format, ##__VA_ARGS__)
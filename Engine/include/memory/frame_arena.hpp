@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Allocators for short-lived data that never touch the global heap in the
+// steady state.
+//
+// FrameArena: a bump allocator for data that lives until the end of the next
+// frame. It is double-buffered so a pipelined frame's data stays valid while
+// the render thread draws it and the main thread builds the next frame. Any
+// thread may allocate; nothing is freed individually.
+//
+// ScratchStack: a per-thread stack for temporaries inside one function. A
+// ScratchScope rewinds everything allocated on the thread since it was opened.
+//
+// FrameAllocator and ScratchAllocator let std::vector and std::basic_string
+// use them. Growing a container leaves its old buffer behind until the reset,
+// so reserve() up front where the size is known.
+namespace Memory {
+
+// Alignment of arena buffers and heap fallbacks; the most either one serves
+constexpr size_t MAX_ARENA_ALIGNMENT = 64;
+
+class FrameArena {
+public:
+    static constexpr size_t BUFFER_COUNT = 2;
+
+    ~FrameArena();
+
+    // Allocates both buffers; call before the first frame
+    void initialize(size_t bytesPerBuffer);
+
+    // Main thread, before the frame starts: reuses the buffer of frameIndex - 2.
+    // The caller makes sure nothing from that frame is still being read.
+    void beginFrame(uint64_t frameIndex);
+
+    // Lock-free bump; falls back to the heap (freed at the buffer's next
+    // reset) when the buffer is full or the arena isn't initialized
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    size_t getCapacity() const { return capacity; }
+    // High-water mark of one frame, overflow included
+    size_t getPeakBytes() const { return peakBytes.load(std::memory_order_relaxed); }
+    uint64_t getOverflowCount() const { return overflowCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Buffer {
+        unsigned char* memory = nullptr;
+        std::atomic<size_t> offset{0};
+        std::atomic<size_t> overflowBytes{0};
+        std::mutex overflowMutex;
+        std::vector<void*> overflowBlocks;
+    };
+
+    void* allocateOverflow(Buffer& buffer, size_t bytes, size_t alignment);
+    void releaseOverflow(Buffer& buffer);
+
+    Buffer buffers[BUFFER_COUNT];
+    std::atomic<Buffer*> current{&buffers[0]};
+    size_t capacity = 0;
+    std::atomic<size_t> peakBytes{0};
+    std::atomic<uint64_t> overflowCount{0};
+    bool overflowReported = false;
+};
+
+// Global frame arena, sized from settings and reset by App::run
+extern FrameArena gFrameArena;
+
+class ScratchStack {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    ~ScratchStack();
+
+    // Outside a ScratchScope, or once the stack is full, the memory comes from
+    // the heap instead; deallocate() frees those blocks and ignores the rest
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    void deallocate(void* pointer);
+
+    size_t getUsedBytes() const { return top; }
+    size_t getPeakBytes() const { return peak; }
+
+private:
+    friend class ScratchScope;
+
+    bool owns(const void* pointer) const;
+
+    unsigned char* base = nullptr;  // allocated on first use
+    size_t capacity = 0;
+    size_t top = 0;
+    size_t peak = 0;
+    int openScopes = 0;
+};
+
+// The calling thread's scratch stack
+ScratchStack& scratch();
+
+// Everything allocated on this thread's scratch stack inside the scope is
+// released when it ends. Containers using ScratchAllocator must not outlive it
+// or leave the thread.
+class ScratchScope {
+public:
+    ScratchScope();
+    ~ScratchScope();
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+private:
+    ScratchStack& stack;
+    size_t marker;
+};
+
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator() = default;
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(gFrameArena.allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>&, const FrameAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>&, const FrameAllocator<U>&) { return false; }
+
+template <typename T>
+class ScratchAllocator {
+public:
+    using value_type = T;
+
+    ScratchAllocator() = default;
+    template <typename U>
+    ScratchAllocator(const ScratchAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(scratch().allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* pointer, size_t) {
+        scratch().deallocate(pointer);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const ScratchAllocator<T>&, const ScratchAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const ScratchAllocator<T>&, const ScratchAllocator<U>&) { return false; }
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+template <typename T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+using ScratchString = std::basic_string<char, std::char_traits<char>, ScratchAllocator<char>>;
+
+} // namespace Memory
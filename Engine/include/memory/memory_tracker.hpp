@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Tagged memory tracking. In development builds the global operator new and
+// delete keep live, peak and allocation counters per subsystem tag; the tag
+// is whatever MEMORY_TAG_SCOPE set on the allocating thread (General when
+// none). Memory is charged to the tag it was allocated under, whichever
+// thread frees it. Production builds keep the default operators and the
+// macro compiles to nothing.
+namespace Memory {
+
+enum class Tag : uint8_t {
+    General,
+    Audio,
+    Input,
+    Renderer,
+    Assets,
+    Count
+};
+
+constexpr bool TRACKING_ENABLED = !PRODUCTION_BUILD;
+
+struct TagStats {
+    uint64_t liveBytes = 0;
+    uint64_t peakBytes = 0;
+    uint64_t allocations = 0;
+    uint64_t bytesAllocated = 0;    // total over the run
+    uint64_t budgetBytes = 0;       // 0 = no budget
+    double allocationsPerFrame = 0.0;
+    uint64_t maxAllocationsPerFrame = 0;
+};
+
+// Sets the calling thread's tag for the lifetime of the scope
+class TagScope {
+public:
+    explicit TagScope(Tag tag);
+    ~TagScope();
+    TagScope(const TagScope&) = delete;
+    TagScope& operator=(const TagScope&) = delete;
+private:
+    Tag previous;
+};
+
+Tag currentTag();
+TagStats getTagStats(Tag tag);
+const char* tagName(Tag tag);
+
+// Budgets warn (once per crossing) when a tag's live bytes exceed them
+void setBudget(Tag tag, uint64_t bytes);
+// "audio:64,renderer:256" in megabytes; unknown tags are reported and skipped
+void parseBudgets(const std::string& spec);
+
+// Main thread, once per frame: allocation rates and budget warnings
+void onFrameEnd();
+
+// Table of every tag; requestReport prints one at the end of the next frame
+void report(std::ostream& out);
+void requestReport();
+
+} // namespace Memory
+
+#define MEMORY_CONCAT_INNER(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+
+#if PRODUCTION_BUILD
+#define MEMORY_TAG_SCOPE(tag) ((void)0)
+#else
+#define MEMORY_TAG_SCOPE(tag) Memory::TagScope MEMORY_CONCAT(memoryTagScope, __LINE__)(tag)
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <profiling/latency_tracer.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// What one frame spent its time on
+enum class FramePhase : uint8_t {
+    ProcessEvents,   // App::processEvents
+    Update,          // App::update (the frame task graph, audio included)
+    Audio,           // piano and mixer systems within the update
+    Render,          // recording, submission and present (render thread in pipelined mode)
+    Gpu,             // GPU time of the frame's command buffer (timestamp queries)
+    Frame,           // start of this frame to start of the next
+    PresentInterval, // previous present to this frame's present
+    Count
+};
+
+// Per-frame timings kept in a ring of the last RING_FRAMES frames (for CSV
+// export) and in one log-bucketed histogram per phase over the whole run (for
+// percentiles). Phases may be timed on any thread; a frame is only fed to the
+// histograms once it has been retired, RETIRE_LAG frames later, when the
+// render thread and the GPU are done with it.
+class FrameStats {
+public:
+    static constexpr size_t RING_FRAMES = 4096;  // power of two
+    static constexpr uint64_t RETIRE_LAG = 4;    // frames until GPU and present timings are in
+
+    void setEnabled(bool enabled) { collecting.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return collecting.load(std::memory_order_relaxed); }
+
+    // Main thread, around each frame
+    void beginFrame(uint64_t frameIndex);
+    void endFrame(uint64_t frameIndex);
+
+    // Add time to a phase of a frame (any thread)
+    void addTime(uint64_t frameIndex, FramePhase phase, uint64_t ns);
+    // Present interval, from the thread that presents
+    void onPresent(uint64_t frameIndex);
+
+    // Retire every frame still pending; call once nothing else is timing frames
+    void flush();
+
+    // Ask the main thread to write a CSV at the end of the current frame (any thread)
+    void requestDump() { dumpRequested.store(true, std::memory_order_relaxed); }
+
+    const LatencyHistogram& getHistogram(FramePhase phase) const { return histograms[static_cast<size_t>(phase)]; }
+
+    // Percentile table per phase, plus the frames that took more than twice the median
+    void report(std::ostream& out) const;
+    // One row per frame in the ring, milliseconds, empty cells for phases not timed
+    bool writeCsv(const std::string& path) const;
+
+    static const char* phaseName(FramePhase phase);
+
+private:
+    struct FrameRow {
+        std::atomic<uint64_t> frameIndex{UINT64_MAX};
+        std::atomic<uint32_t> timedPhases{0};   // bit per FramePhase
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(FramePhase::Count)> ns{};
+    };
+
+    void retire(uint64_t frameIndex);
+
+    std::atomic<bool> collecting{false};
+    std::atomic<bool> dumpRequested{false};
+    std::array<LatencyHistogram, static_cast<size_t>(FramePhase::Count)> histograms;
+    std::array<FrameRow, RING_FRAMES> rows;
+
+    // Main thread only
+    uint64_t frameStartNs = 0;
+    uint64_t firstFrame = UINT64_MAX;
+    uint64_t nextRetire = 0;
+    uint64_t lastFrame = 0;
+    uint32_t dumpCount = 0;
+
+    // Presenting thread only
+    uint64_t lastPresentNs = 0;
+};
+
+// Global frame statistics, enabled from the settings (frameStats)
+extern FrameStats gFrameStats;
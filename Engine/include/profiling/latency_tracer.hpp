@@ -0,0 +1,127 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+// Latency histogram with logarithmic buckets: exact below 8 us, then eight
+// buckets per power of two (at most 12.5% wide) up to about 33 s. Recording is
+// lock-free so the input, main and audio threads can all feed one histogram.
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKETS = 8;
+    static constexpr size_t BUCKET_COUNT = 184;
+
+    void record(uint64_t latencyNs);
+    void reset();
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getMeanNs() const;
+    uint64_t getMaxNs() const { return maxNs.load(std::memory_order_relaxed); }
+    // Upper edge of the bucket holding the given fraction (0..1) of the samples
+    uint64_t getPercentileNs(double fraction) const;
+
+    uint64_t getBucketCount(size_t bucket) const { return buckets[bucket].load(std::memory_order_relaxed); }
+    static size_t bucketOf(uint64_t latencyUs);
+    static uint64_t bucketLowerUs(size_t bucket);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sumNs{0};
+    std::atomic<uint64_t> maxNs{0};
+};
+
+// Points along the two paths an input event takes; every stage is measured
+// from the SDL timestamp of the input event (event.common.timestamp)
+enum class LatencyStage : uint8_t {
+    // Input to photon, for every input event App::processEvents handles
+    Dispatch,       // App::dispatchEvent handled the event
+    Update,         // App::update finished the frame that saw it
+    Submit,         // that frame's command buffer went to vkQueueSubmit
+    Present,        // vkQueuePresentKHR returned for that frame (proxy for scan-out)
+    // Input to sound, for every note played from a key event
+    PlayNote,       // Piano::playNote started
+    NoteOn,         // the mixer queued the note's samples
+    FirstSample,    // estimated time the first audible sample leaves the device
+    Count
+};
+
+// Follows input events through the frame and the note pipeline and keeps one
+// latency histogram per stage. Disabled by default; when disabled every hook
+// is a single relaxed load.
+class LatencyTracer {
+public:
+    static constexpr size_t MAX_FRAME_EVENTS = 128; // per frame, later events are counted as dropped
+    static constexpr size_t MAX_SOUND_TRACES = 64;  // notes in flight, power of two
+
+    // Input timestamps of the events one frame handled. takeFrameEvents puts
+    // them in the frame arena, so they stay valid until the frame is drawn.
+    struct FrameEvents {
+        const uint64_t* timestamps = nullptr;
+        size_t count = 0;
+    };
+
+    void setEnabled(bool enabled) { tracing.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return tracing.load(std::memory_order_relaxed); }
+
+    // Input to photon. Events and the Update stage are recorded on the main
+    // thread; takeFrameEvents closes the frame and hands its events to the
+    // render snapshot, so Submit and Present can be stamped by whichever
+    // thread draws it.
+    void onFrameEvent(const SDL_Event& event);
+    void onFrameStage(LatencyStage stage);
+    void onFrameStage(LatencyStage stage, const FrameEvents& events);
+    void takeFrameEvents(FrameEvents& events);
+
+    // Input to sound. A trace id follows one note from the key event to the
+    // audio device; 0 means untraced and is ignored by onSoundStage.
+    uint32_t beginSound(uint64_t inputTimestampNs);
+    void onSoundStage(uint32_t traceId, LatencyStage stage, uint64_t timeNs = 0);
+
+    // Makes a key event's sound trace current on this thread, so the calls it
+    // makes (Piano -> mixer -> AudioSystem) can stamp it without passing it along
+    class SoundScope {
+    public:
+        explicit SoundScope(const SDL_Event& event);
+        ~SoundScope();
+        SoundScope(const SoundScope&) = delete;
+        SoundScope& operator=(const SoundScope&) = delete;
+    private:
+        uint32_t previous;
+    };
+    static uint32_t currentSoundTrace();
+
+    const LatencyHistogram& getHistogram(LatencyStage stage) const { return histograms[static_cast<size_t>(stage)]; }
+    uint64_t getDroppedEvents() const { return droppedEvents; }
+
+    // Summary table for every stage plus the end-to-end histograms
+    void report(std::ostream& out) const;
+    void writeHistogram(std::ostream& out, LatencyStage stage) const;
+    void reset();
+
+    static const char* stageName(LatencyStage stage);
+    static bool isTracedEvent(const SDL_Event& event);
+
+private:
+    struct SoundTrace {
+        std::atomic<uint32_t> id{0};
+        std::atomic<uint64_t> inputNs{0};
+    };
+
+    std::atomic<bool> tracing{false};
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyStage::Count)> histograms;
+
+    // Events handled in the current frame (main thread only)
+    std::array<uint64_t, MAX_FRAME_EVENTS> frameTimestamps{};
+    size_t frameEventCount = 0;
+    uint64_t droppedEvents = 0;
+
+    std::array<SoundTrace, MAX_SOUND_TRACES> soundTraces;
+    std::atomic<uint32_t> nextSoundTrace{1};
+};
+
+// Global tracer, enabled from the settings (latencyTrace)
+extern LatencyTracer gLatencyTracer;
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Raw profiler timestamp: the CPU timestamp counter where there is one (a few
+// cycles to read), SDL's performance counter elsewhere. Captures calibrate it
+// against SDL_GetTicksNS and export nanoseconds.
+inline uint64_t readProfileTicks() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return SDL_GetPerformanceCounter();
+#endif
+}
+
+// Scope profiler for hot paths. Scopes only record while a capture is running;
+// each thread writes into its own ring buffer without locks, and a capture of
+// N frames is written out as a Chrome trace (chrome://tracing, ui.perfetto.dev).
+// Ring buffers are made the first time a thread records and live as long as
+// the process, so keep scopes out of short-lived threads.
+class FrameProfiler {
+public:
+    static constexpr size_t EVENTS_PER_THREAD = size_t(1) << 16; // per ring, power of two
+
+    // Capture the next `frames` frames, starting at the next frame boundary (any thread)
+    void requestCapture(uint32_t frames) { requestedFrames.store(frames, std::memory_order_relaxed); }
+    bool isCapturing() const { return capturing.load(std::memory_order_relaxed); }
+
+    // Main thread, once at the start of every frame: starts and ends captures
+    // and records the frame itself
+    void onFrameBoundary();
+
+    // End a running capture early and write it (shutdown)
+    void stopCapture();
+
+    // Record one finished scope on the calling thread
+    void record(const char* name, uint64_t startTicks, uint64_t endTicks);
+
+private:
+    struct Event {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> startTicks{0};
+        std::atomic<uint64_t> endTicks{0};
+    };
+
+    // Single producer (the owning thread); the exporter validates what it
+    // copied against head afterwards, like a seqlock
+    struct ThreadBuffer {
+        std::unique_ptr<Event[]> events;
+        std::atomic<uint64_t> head{0};
+        uint32_t threadId = 0;
+        std::string threadName;
+    };
+
+    ThreadBuffer* registerThread();
+    void beginCapture(uint32_t frames, uint64_t nowTicks);
+    void endCapture(uint64_t nowTicks);
+    bool writeChromeTrace(const std::string& path);
+
+    std::atomic<bool> capturing{false};
+    std::atomic<uint32_t> requestedFrames{0};
+
+    // Main thread only
+    uint32_t framesLeft = 0;
+    uint64_t frameStartTicks = 0;
+    uint64_t captureStartTicks = 0;
+    uint64_t captureStartNs = 0;
+    uint64_t captureEndTicks = 0;
+    uint64_t captureEndNs = 0;
+    uint32_t captureCount = 0;
+
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+// Global profiler, captures are triggered by the PROFILE_CAPTURE action
+extern FrameProfiler gProfiler;
+
+inline void FrameProfiler::record(const char* name, uint64_t startTicks, uint64_t endTicks) {
+    static thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        buffer = registerThread();
+    }
+
+    uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    Event& event = buffer->events[index & (EVENTS_PER_THREAD - 1)];
+    event.name.store(name, std::memory_order_relaxed);
+    event.startTicks.store(startTicks, std::memory_order_relaxed);
+    event.endTicks.store(endTicks, std::memory_order_relaxed);
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+// Records the enclosing scope; the name must outlive the capture (a literal)
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(gProfiler.isCapturing() ? name : nullptr) {
+        if (this->name) {
+            startTicks = readProfileTicks();
+        }
+    }
+    ~ProfileScope() {
+        if (name) {
+            gProfiler.record(name, startTicks, readProfileTicks());
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t startTicks = 0;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Compiled out of production builds
+#if PRODUCTION_BUILD
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <profiling/latency_tracer.hpp>
+#include <array>
+#include <cstdint>
+
+// Everything the renderer needs to draw one frame, copied out of the
+// simulation at the end of App::update. The renderer only ever reads it, so in
+// pipelined mode the simulation can move on to the next frame while this one
+// is being recorded and submitted.
+struct RenderSnapshot {
+    uint64_t frameIndex = 0;
+    
+    // Blend factor between the last two fixed simulation steps
+    float interpolationAlpha = 0.0f;
+    
+    std::array<float, 4> clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+    
+    // Swapchain recreation requested by a window resize this frame
+    bool windowResized = false;
+    int width = 0;
+    int height = 0;
+    
+    // Input events handled this frame, stamped at submit and present
+    LatencyTracer::FrameEvents latencyEvents;
+};
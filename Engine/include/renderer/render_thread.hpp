@@ -0,0 +1,56 @@
+#pragma once
+
+#include <renderer/render_snapshot.hpp>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Draws frames on a thread of its own from double-buffered render snapshots,
+// so the main thread can simulate frame N+1 while frame N is recorded,
+// submitted and waited on. At most one frame is queued behind the one being
+// drawn; submit() blocks beyond that, which keeps the simulation from running
+// ahead of the screen.
+class RenderThread {
+public:
+    using DrawFunction = std::function<void(const RenderSnapshot&)>;
+    
+    ~RenderThread();
+    
+    void start(DrawFunction draw);
+    // Draws the frame still queued, then joins the thread
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+    
+    // Copy the snapshot into the free buffer and hand it to the render thread.
+    // Rethrows an exception the draw function threw on the render thread; the
+    // thread has stopped drawing by then, so every later call rethrows it too.
+    void submit(const RenderSnapshot& snapshot);
+    
+    // Block until the snapshot for frameIndex has been drawn, so per-frame
+    // data it points to (the frame arena) can be reused. Rethrows like submit().
+    void waitUntilDrawn(uint64_t frameIndex);
+    
+    // Time submit() and waitUntilDrawn() spent blocked on the render thread, for profiling
+    uint64_t getSubmitWaitNs() const { return submitWaitNs; }
+    
+private:
+    void threadMain();
+    
+    DrawFunction draw;
+    std::thread thread;
+    
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::array<RenderSnapshot, 2> snapshots;
+    size_t writeSlot = 0;     // buffer submit() fills next
+    bool pending = false;     // the other buffer holds a frame not picked up yet
+    bool stopping = false;
+    uint64_t drawnFrames = 0; // one past the last frame index drawn
+    std::exception_ptr error; // sticky: set once the draw function threw
+    
+    uint64_t submitWaitNs = 0;
+};
@@ -2,6 +2,7 @@
 
 #include <SDL3/SDL.h>
 #include <vulkan/vulkan.h>
+#include <renderer/render_snapshot.hpp>
 #include <vector>
 
 class Renderer {
@@ -12,8 +13,8 @@ public:
     // Destructor handles cleanup
     ~Renderer();
     
-    // Draw a frame
-    void drawFrame();
+    // Draw a frame from its snapshot; safe to call from the render thread
+    void drawFrame(const RenderSnapshot& snapshot);
     
     // Handle window resize events
     void handleWindowResize(int width, int height);
@@ -56,6 +57,14 @@ private:
     VkSemaphore renderFinishedSemaphore;
     VkFence inFlightFence;
     
+    // GPU frame time: timestamps around the command buffer, read back once
+    // the fence says the frame finished
+    VkQueryPool timestampPool = VK_NULL_HANDLE;
+    float timestampPeriodNs = 0.0f;
+    bool gpuTimingSupported = false;
+    bool gpuQueryPending = false;
+    uint64_t gpuQueryFrame = 0;
+    
     // Initialization methods
     void initVulkan();
     void createInstance();
@@ -63,6 +72,7 @@ private:
     void pickPhysicalDevice();
     void createLogicalDevice();
     void createSwapChain();
+    VkPresentModeKHR choosePresentMode();
     void createImageViews();
     void createRenderPass();
     void createFramebuffers();
@@ -71,6 +81,7 @@ private:
     void createCommandPool();
     void createCommandBuffer();
     void createSyncObjects();
+    void createQueryPool();
     
     // Cleanup resources
     void cleanup();
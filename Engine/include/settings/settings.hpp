@@ -1,6 +1,8 @@
 #ifndef SETTINGS_HPP
 #define SETTINGS_HPP
 
+#include <cstdint>
+#include <exception>
 #include <string>
 #include <fstream>
 #include <iostream>
@@ -10,9 +12,33 @@ struct Settings {
     int screenHeight    = 1080;      // screen height
     bool fullscreen     = false;    // fullscreen mode
     bool vsync          = true;     // vertical sync
-    int maxFPS          = 60;       // maximum frames per second
+    int maxFPS          = 60;       // maximum frames per second (0 = unlimited)
+    int simulationHz    = 60;       // fixed game logic steps per second
+    std::string renderMode = "serial"; // serial, or pipelined: render thread draws frame N while frame N+1 simulates
     int audioVolume     = 100;      // audio volume (0-100)
     
+    // Thread scheduling: priority is normal/high/rr/fifo, affinity is a CPU bit mask (0 = any CPU)
+    std::string mainThreadPriority   = "normal";
+    uint64_t mainThreadAffinity      = 0;
+    std::string audioThreadPriority  = "fifo";
+    uint64_t audioThreadAffinity     = 0;
+    std::string inputThreadPriority  = "high";
+    uint64_t inputThreadAffinity     = 0;
+    std::string workerThreadPriority = "normal";
+    uint64_t workerThreadAffinity    = 0;
+    int workerThreads                = 0;       // job system workers incl. the main thread (0 = one per core)
+    bool lockMemory                  = false;   // mlockall for real-time threads
+    
+    std::string inputTraceLevel      = "off";   // input logging: off/edges/held
+    bool latencyTrace                = false;   // input-to-photon/sound latency histograms, printed at exit
+    int profileCaptureFrames         = 120;     // frames per profiler capture (PROFILE_CAPTURE action)
+    bool frameStats                  = false;   // per-phase frame time percentiles, printed and written to CSV at exit
+    std::string memoryBudgets        = "audio:64,input:8,renderer:256,assets:512"; // per-tag budgets in MB
+    int frameArenaKB                 = 1024;    // per-frame bump allocator, per buffer (two buffers)
+    std::string logLevel             = "info";  // debug, info, warning or error
+    std::string logCategories        = "all";   // all, or a list of general, audio, input, renderer
+    std::string logFile              = "";      // also write log records here as JSON lines
+    
     // Load settings from file
     bool loadFromFile(const std::string& filename) {
         std::ifstream file(filename);
@@ -41,13 +67,38 @@ struct Settings {
             value.erase(0, value.find_first_not_of(" \t"));
             value.erase(value.find_last_not_of(" \t") + 1);
             
-            // Parse the settings
-            if (key == "screenWidth") screenWidth = std::stoi(value);
-            else if (key == "screenHeight") screenHeight = std::stoi(value);
-            else if (key == "fullscreen") fullscreen = (value == "true" || value == "1");
-            else if (key == "vsync") vsync = (value == "true" || value == "1");
-            else if (key == "maxFPS") maxFPS = std::stoi(value);
-            else if (key == "audioVolume") audioVolume = std::stoi(value);
+            // Parse the settings; a malformed number keeps the default
+            try {
+                if (key == "screenWidth") screenWidth = std::stoi(value);
+                else if (key == "screenHeight") screenHeight = std::stoi(value);
+                else if (key == "fullscreen") fullscreen = (value == "true" || value == "1");
+                else if (key == "vsync") vsync = (value == "true" || value == "1");
+                else if (key == "maxFPS") maxFPS = std::stoi(value);
+                else if (key == "simulationHz") simulationHz = std::stoi(value);
+                else if (key == "renderMode") renderMode = value;
+                else if (key == "audioVolume") audioVolume = std::stoi(value);
+                else if (key == "mainThreadPriority") mainThreadPriority = value;
+                else if (key == "mainThreadAffinity") mainThreadAffinity = std::stoull(value, nullptr, 0);
+                else if (key == "audioThreadPriority") audioThreadPriority = value;
+                else if (key == "audioThreadAffinity") audioThreadAffinity = std::stoull(value, nullptr, 0);
+                else if (key == "inputThreadPriority") inputThreadPriority = value;
+                else if (key == "inputThreadAffinity") inputThreadAffinity = std::stoull(value, nullptr, 0);
+                else if (key == "workerThreadPriority") workerThreadPriority = value;
+                else if (key == "workerThreadAffinity") workerThreadAffinity = std::stoull(value, nullptr, 0);
+                else if (key == "workerThreads") workerThreads = std::stoi(value);
+                else if (key == "lockMemory") lockMemory = (value == "true" || value == "1");
+                else if (key == "inputTraceLevel") inputTraceLevel = value;
+                else if (key == "latencyTrace") latencyTrace = (value == "true" || value == "1");
+                else if (key == "profileCaptureFrames") profileCaptureFrames = std::stoi(value);
+                else if (key == "frameStats") frameStats = (value == "true" || value == "1");
+                else if (key == "memoryBudgets") memoryBudgets = value;
+                else if (key == "frameArenaKB") frameArenaKB = std::stoi(value);
+                else if (key == "logLevel") logLevel = value;
+                else if (key == "logCategories") logCategories = value;
+                else if (key == "logFile") logFile = value;
+            } catch (const std::exception&) {
+                std::cout << "Invalid value for setting " << key << ": '" << value << "', keeping the default" << std::endl;
+            }
         }
         
         return true;
@@ -67,7 +118,28 @@ struct Settings {
         file << "fullscreen = " << (fullscreen ? "true" : "false") << "\n";
         file << "vsync = " << (vsync ? "true" : "false") << "\n";
         file << "maxFPS = " << maxFPS << "\n";
+        file << "simulationHz = " << simulationHz << "\n";
+        file << "renderMode = " << renderMode << "\n";
         file << "audioVolume = " << audioVolume << "\n";
+        file << "mainThreadPriority = " << mainThreadPriority << "\n";
+        file << "mainThreadAffinity = 0x" << std::hex << mainThreadAffinity << std::dec << "\n";
+        file << "audioThreadPriority = " << audioThreadPriority << "\n";
+        file << "audioThreadAffinity = 0x" << std::hex << audioThreadAffinity << std::dec << "\n";
+        file << "inputThreadPriority = " << inputThreadPriority << "\n";
+        file << "inputThreadAffinity = 0x" << std::hex << inputThreadAffinity << std::dec << "\n";
+        file << "workerThreadPriority = " << workerThreadPriority << "\n";
+        file << "workerThreadAffinity = 0x" << std::hex << workerThreadAffinity << std::dec << "\n";
+        file << "workerThreads = " << workerThreads << "\n";
+        file << "lockMemory = " << (lockMemory ? "true" : "false") << "\n";
+        file << "inputTraceLevel = " << inputTraceLevel << "\n";
+        file << "latencyTrace = " << (latencyTrace ? "true" : "false") << "\n";
+        file << "profileCaptureFrames = " << profileCaptureFrames << "\n";
+        file << "frameStats = " << (frameStats ? "true" : "false") << "\n";
+        file << "memoryBudgets = " << memoryBudgets << "\n";
+        file << "frameArenaKB = " << frameArenaKB << "\n";
+        file << "logLevel = " << logLevel << "\n";
+        file << "logCategories = " << logCategories << "\n";
+        file << "logFile = " << logFile << "\n";
         
         return true;
     }
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Threading {
+
+class JobCounter;
+
+// One unit of work. Jobs come from fixed per-thread pools and the callable is
+// stored inline, so submitting never allocates.
+struct alignas(64) Job {
+    static constexpr size_t PAYLOAD_SIZE = 32;
+
+    void (*function)(Job& job) = nullptr;
+    JobCounter* counter = nullptr;      // decremented when the job finishes
+    Job* nextWaiter = nullptr;          // link while parked on a dependency
+    std::atomic<bool> busy{false};      // from allocation until the callable returned
+    alignas(8) unsigned char payload[PAYLOAD_SIZE];
+};
+static_assert(sizeof(Job) == 64, "Jobs are meant to fill exactly one cache line");
+
+// Counts unfinished jobs. Waiting on a counter runs other jobs meanwhile, and
+// jobs submitted with submitAfter start once the counter drops to zero.
+class JobCounter {
+public:
+    // Once this is true the job system no longer touches the counter, so it
+    // may go out of scope
+    bool isDone() const { return state.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    // Unfinished jobs, plus a lock bit guarding the waiters list; the lock is
+    // in the same word so a counter never reads as done while it is held
+    static constexpr uint32_t LOCKED = 0x80000000u;
+
+    std::atomic<uint32_t> state{0};
+    Job* waiters = nullptr;
+};
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing
+// for Weak Memory Models"). The owning worker pushes and pops at the bottom,
+// other workers steal from the top. Fixed capacity; push fails when full.
+class JobDeque {
+public:
+    static constexpr int64_t CAPACITY = 4096; // power of two
+
+    JobDeque();
+
+    bool push(Job* job);
+    Job* pop();
+    Job* steal();
+
+private:
+    std::unique_ptr<std::atomic<Job*>[]> jobs;
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+};
+
+// Work-stealing job system: one worker per core, each with its own deque and
+// job pool. The thread that calls start() becomes worker 0 and takes part
+// whenever it waits. Threads outside the system may submit too; their jobs go
+// through a shared injection queue.
+class JobSystem {
+public:
+    // Job slots per submitting thread, power of two. Slots still in use (parked
+    // on a dependency, queued or running) are skipped; a thread with this many
+    // unfinished jobs at once is a bug and aborts.
+    static constexpr size_t JOB_POOL_SIZE = 2 * JobDeque::CAPACITY;
+
+    ~JobSystem();
+
+    // workerCount <= 0 uses one worker per core, the calling thread included
+    void start(int workerCount = 0);
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+    size_t getWorkerCount() const { return workers.size(); }
+
+    // Run function() on any worker; counter (optional) tracks completion
+    template <typename Function>
+    void submit(Function&& function, JobCounter* counter = nullptr) {
+        schedule(makeJob(std::forward<Function>(function), counter));
+    }
+
+    // Run function() once dependency has reached zero
+    template <typename Function>
+    void submitAfter(JobCounter& dependency, Function&& function, JobCounter* counter = nullptr) {
+        scheduleAfter(dependency, makeJob(std::forward<Function>(function), counter));
+    }
+
+    // Call function(first, last) over [begin, end) in chunks of at most
+    // grainSize (0 picks one from the worker count) and wait for all of them
+    template <typename Function>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, Function&& function);
+
+    // Run jobs until the counter reaches zero
+    void wait(JobCounter& counter);
+
+    // Index of the calling worker, -1 on threads outside the system
+    static int currentWorkerIndex();
+
+private:
+    struct Worker {
+        JobDeque deque;
+        std::unique_ptr<Job[]> pool;
+        size_t nextPoolJob = 0;
+        uint64_t stealSeed = 0;
+        std::thread thread;
+    };
+
+    template <typename Function>
+    struct RangeContext {
+        Function& function;
+        JobCounter counter;
+        size_t grainSize;
+        JobSystem* system;
+    };
+
+    template <typename Function>
+    Job* makeJob(Function&& function, JobCounter* counter);
+    Job* allocateJob();
+    static Job* claimSlot(Job* pool, size_t& next);
+
+    template <typename Function>
+    static void splitRange(RangeContext<Function>& context, size_t begin, size_t end);
+
+    void schedule(Job* job);
+    void scheduleAfter(JobCounter& dependency, Job* job);
+    void execute(Job* job);
+    void finish(JobCounter& counter);
+    Job* findJob(int workerIndex);
+    void workerMain(int workerIndex);
+    void wakeWorkers();
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> running{false};
+
+    // Jobs submitted from threads that are not workers
+    std::mutex injectionMutex;
+    std::vector<Job*> injectionQueue;
+    std::atomic<size_t> injectionCount{0};
+    std::unique_ptr<Job[]> externalPool;
+    size_t nextExternalJob = 0;
+
+    // Idle workers sleep until new work is published
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<uint64_t> workEpoch{0};
+    std::atomic<int> sleepingWorkers{0};
+};
+
+template <typename Function>
+Job* JobSystem::makeJob(Function&& function, JobCounter* counter) {
+    using Callable = std::decay_t<Function>;
+    static_assert(sizeof(Callable) <= Job::PAYLOAD_SIZE, "Job captures too much; capture a pointer to the data instead");
+    static_assert(alignof(Callable) <= 8, "Job callable is over-aligned");
+
+    Job* job = allocateJob();
+    new (job->payload) Callable(std::forward<Function>(function));
+    job->function = [](Job& self) {
+        Callable* callable = std::launder(reinterpret_cast<Callable*>(self.payload));
+        (*callable)();
+        callable->~Callable();
+    };
+    job->counter = counter;
+    job->nextWaiter = nullptr;
+    if (counter) {
+        counter->state.fetch_add(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+template <typename Function>
+void JobSystem::splitRange(RangeContext<Function>& context, size_t begin, size_t end) {
+    // Hand the upper half to the pool until the rest is one chunk; thieves
+    // take the largest halves first, so work spreads in log(n) steps
+    while (end - begin > context.grainSize) {
+        size_t middle = begin + (end - begin) / 2;
+        RangeContext<Function>* shared = &context;
+        context.system->submit([shared, middle, end]() { splitRange(*shared, middle, end); }, &context.counter);
+        end = middle;
+    }
+    context.function(begin, end);
+}
+
+template <typename Function>
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grainSize, Function&& function) {
+    if (begin >= end) {
+        return;
+    }
+    if (grainSize == 0) {
+        size_t chunks = std::max<size_t>(workers.size(), 1) * 4;
+        grainSize = std::max<size_t>((end - begin + chunks - 1) / chunks, 1);
+    }
+
+    RangeContext<std::remove_reference_t<Function>> context{function, {}, grainSize, this};
+    if (!isRunning()) {
+        context.function(begin, end);
+        return;
+    }
+    splitRange(context, begin, end);
+    wait(context.counter);
+}
+
+// Global job system, started by App::run
+extern JobSystem Jobs;
+
+} // namespace Threading
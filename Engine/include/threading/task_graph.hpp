@@ -0,0 +1,85 @@
+#pragma once
+
+#include <threading/job_system.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Threading {
+
+// Per-frame graph of systems that declare which named resources they read and
+// write. Systems that touch a resource are ordered as they were added
+// (read-after-write, write-after-read and write-after-write); everything else
+// runs concurrently on the job system. The graph is built once and only
+// rebuilt after systems are added.
+class TaskGraph {
+public:
+    using SystemId = uint16_t;
+
+    SystemId addSystem(const std::string& name,
+                       std::initializer_list<const char*> reads,
+                       std::initializer_list<const char*> writes,
+                       std::function<void()> run);
+
+    // Run every system once and wait for all of them
+    void execute(JobSystem& jobs);
+
+    // Write the next executed frame as a Graphviz graph with per-node timings
+    void requestExport(const std::string& path) { exportPath = path; }
+
+    size_t getSystemCount() const { return systems.size(); }
+
+private:
+    using ResourceId = uint16_t;
+
+    struct Edge {
+        SystemId to;
+        ResourceId resource;
+    };
+
+    struct System {
+        std::string name;
+        std::vector<ResourceId> reads;
+        std::vector<ResourceId> writes;
+        std::function<void()> run;
+
+        // Built by build()
+        std::vector<Edge> successors;
+        uint32_t dependencyCount = 0;
+    };
+
+    struct Timing {
+        uint64_t startNs = 0;
+        uint64_t endNs = 0;
+        int worker = -1;
+    };
+
+    ResourceId resourceId(const char* name);
+    void build();
+    void runSystem(SystemId id);
+    void addEdge(SystemId from, SystemId to, ResourceId resource);
+    bool writeGraph(const std::string& path, uint64_t frameStartNs) const;
+
+    std::vector<System> systems;
+    std::unordered_map<std::string, ResourceId> resourceIds;
+    std::vector<std::string> resourceNames;
+    bool dirty = true;
+
+    // Per-execution state
+    std::unique_ptr<std::atomic<uint32_t>[]> remaining;
+    std::vector<SystemId> roots;
+    JobSystem* activeJobs = nullptr;
+    JobCounter* activeCounter = nullptr;
+
+    // Debug export
+    std::string exportPath;
+    bool recordTimings = false;
+    std::vector<Timing> timings;
+};
+
+} // namespace Threading
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Threading {
+
+// Requested scheduling class, from least to most aggressive
+enum class SchedulingClass {
+    Normal,
+    High,                // raised niceness / above-normal priority
+    RealTimeRoundRobin,  // SCHED_RR where permitted
+    RealTimeFifo         // SCHED_FIFO where permitted
+};
+
+// Engine thread roles that can be configured from the settings file
+enum class ThreadRole {
+    Main,   // event processing, update and render submission
+    Audio,  // SDL audio device thread (configured from inside the mixer)
+    Input,  // input dispatch thread for latency-critical consumers
+    Worker  // background workers (note lifecycles, jobs)
+};
+
+struct ThreadConfig {
+    std::string name;                       // shown in debuggers/profilers (15 chars on Linux)
+    SchedulingClass schedulingClass = SchedulingClass::Normal;
+    uint64_t affinityMask = 0;              // bit n = CPU n, 0 leaves the OS default
+    size_t prefaultStackBytes = 0;          // stack touched up front so real-time code doesn't page fault
+    bool lockMemory = false;                // lock process pages in RAM (mlockall) where permitted
+};
+
+// What the OS actually granted for a configured thread
+struct ThreadReport {
+    std::string name;
+    SchedulingClass requested = SchedulingClass::Normal;
+    SchedulingClass granted = SchedulingClass::Normal;
+    uint64_t requestedAffinity = 0;
+    bool affinityApplied = false;
+    bool nameApplied = false;
+    bool stackPrefaulted = false;
+    bool memoryLocked = false;
+};
+
+// Apply a configuration to the calling thread; the report is also recorded
+ThreadReport applyToCurrentThread(const ThreadConfig& config);
+
+// Name the calling thread was configured with, empty if it never was
+const std::string& currentThreadName();
+
+// Configuration for an engine role, taken from g_settings
+ThreadConfig configForRole(ThreadRole role, const std::string& name);
+
+// Create a thread that applies its configuration before running the function
+template <typename Function>
+std::thread createThread(const ThreadConfig& config, Function&& function) {
+    return std::thread([config, function = std::forward<Function>(function)]() mutable {
+        applyToCurrentThread(config);
+        function();
+    });
+}
+
+// Reports of every configured thread so far
+std::vector<ThreadReport> getThreadReports();
+
+// Parsing helpers used by the settings file ("normal", "high", "rr", "fifo")
+SchedulingClass parseSchedulingClass(const std::string& value);
+const char* schedulingClassName(SchedulingClass schedulingClass);
+
+} // namespace Threading
@@ -1,10 +1,21 @@
 #include <app/app.hpp>
 #include <Inputs/keyboard.hpp>
+#include <inputs/combos.hpp>
+#include <config/resource_paths.hpp>
 #include <settings/settings.hpp>
 #include <stdexcept>
 #include <iostream>
+#include <iomanip>
+#include <algorithm>
 #include <audio/audio.hpp>
 #include <audio/mixer.hpp>
+#include <threading/threading.hpp>
+#include <threading/job_system.hpp>
+#include <profiling/latency_tracer.hpp>
+#include <profiling/profiler.hpp>
+#include <profiling/frame_stats.hpp>
+#include <memory/memory_tracker.hpp>
+#include <memory/frame_arena.hpp>
 
 
 
@@ -24,12 +35,18 @@ App::~App() {
 }
 
 bool App::initialize() {
-    // Initialize SDL
-    if (!SDL_Init(SDL_INIT_VIDEO)) {
+    // Initialize SDL; headless runs need events (replays, gamepads) but no video
+    if (!SDL_Init(headless ? SDL_INIT_GAMEPAD : SDL_INIT_VIDEO | SDL_INIT_GAMEPAD)) {
         std::cerr << "Failed to initialize SDL: " << SDL_GetError() << std::endl;
         return false;
     }
     
+    if (headless) {
+        std::cout << "Running headless: no window or renderer" << std::endl;
+        running = true;
+        return true;
+    }
+    
     // Create window with Vulkan support
     window = SDL_CreateWindow(title.c_str(), width, height, SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE);
     
@@ -52,28 +69,131 @@ bool App::initialize() {
 }
 
 void App::run() {
+    // Apply scheduling/affinity from the settings to the main thread
+    Threading::applyToCurrentThread(Threading::configForRole(Threading::ThreadRole::Main, "main"));
+    
+    // Input logging stays off unless requested in the settings
+    Keyboard::Input.setTraceLevel(Keyboard::KeyboardManager::parseTraceLevel(g_settings.inputTraceLevel));
+    
+    // Input-to-photon and input-to-sound latency, reported at exit
+    gLatencyTracer.setEnabled(g_settings.latencyTrace);
+    
+    // Per-phase frame timings, reported and written to frame_stats.csv at exit
+    gFrameStats.setEnabled(g_settings.frameStats);
+    
+    // Per-subsystem memory budgets; exceeding one prints a warning
+    Memory::parseBudgets(g_settings.memoryBudgets);
+    
+    // Bump allocator for per-frame data, reset as each frame starts
+    Memory::gFrameArena.initialize(static_cast<size_t>(std::max(g_settings.frameArenaKB, 0)) * 1024);
+    
+    // Combos are matched as action presses arrive
+    Keyboard::Combos.loadFromFile(Config::COMBO_CONFIG_FILE, Keyboard::Input);
+    Keyboard::Combos.attach(Keyboard::Input);
+    
+    // Profiler captures are written as Chrome traces (profile_capture_<n>.json)
+    Keyboard::Input.registerActionCallback("PROFILE_CAPTURE", []() {
+        gProfiler.requestCapture(static_cast<uint32_t>(std::max(g_settings.profileCaptureFrames, 1)));
+    });
+    Keyboard::Input.registerActionCallback("FRAME_STATS_DUMP", []() {
+        gFrameStats.requestDump();
+        Memory::requestReport();
+    });
+    
+    // Workers for engine and gameplay jobs; this thread is worker 0
+    Threading::Jobs.start(g_settings.workerThreads);
+    
     // Initialize the piano system when the app starts running
     InitializePiano();
     
     // Initialize the audio mixer
     InitializeAudioMixer();
     
+    // Piano notes are latency critical, so they are played from the input thread
+    inputThread.addListener([](const SDL_Event& event) {
+        if (gPiano) {
+            gPiano->handleNoteEvent(event);
+        }
+    });
+    inputThread.start();
+    
+    frameScheduler.configure(g_settings.maxFPS, g_settings.simulationHz);
+    buildFrameGraph();
+    
+    // Pipelined: this thread simulates frame N+1 while the render thread draws frame N
+    if (g_settings.renderMode == "pipelined") {
+        if (renderer) {
+            renderThread.start([this](const RenderSnapshot& snapshot) { drawSnapshot(snapshot); });
+        } else {
+            std::cout << "renderMode 'pipelined' is ignored when headless" << std::endl;
+        }
+    } else if (g_settings.renderMode != "serial") {
+        std::cerr << "Unknown renderMode '" << g_settings.renderMode << "', using serial" << std::endl;
+    }
+    
+    runStartNs = SDL_GetTicksNS();
+    
     while (running) {
+        frameScheduler.beginFrame();
+        gProfiler.onFrameBoundary();
+        gFrameStats.beginFrame(frameIndex);
+        
+        // This frame reuses the arena buffer of two frames back, which the
+        // render thread may still be drawing in pipelined mode (its snapshot's
+        // latency events live there)
+        if (frameIndex >= Memory::FrameArena::BUFFER_COUNT) {
+            renderThread.waitUntilDrawn(frameIndex - Memory::FrameArena::BUFFER_COUNT);
+        }
+        Memory::gFrameArena.beginFrame(frameIndex);
+        uint64_t frameStartNs = SDL_GetTicksNS();
+        
         processEvents();
         
+        uint64_t updateStartNs = SDL_GetTicksNS();
+        gFrameStats.addTime(frameIndex, FramePhase::ProcessEvents, updateStartNs - frameStartNs);
         update();
+        gFrameStats.addTime(frameIndex, FramePhase::Update, SDL_GetTicksNS() - updateStartNs);
         
-        // Update the audio mixer to handle fade-outs
-        if (gAudioMixer) {
-            gAudioMixer->Update();
-        }
+        render();
+        gFrameStats.endFrame(frameIndex);
+        Memory::onFrameEnd();
         
-        // Piano update - this will handle any piano-specific updates
-        if (gPiano) {
-            gPiano->update();
+        frameIndex++;
+        
+        uint64_t frameWorkNs = SDL_GetTicksNS() - frameStartNs;
+        frameWorkTotalNs += frameWorkNs;
+        frameWorkMinNs = std::min(frameWorkMinNs, frameWorkNs);
+        frameWorkMaxNs = std::max(frameWorkMaxNs, frameWorkNs);
+        if (frameLimit > 0 && frameIndex >= frameLimit) {
+            break;
         }
         
-        render();
+        // Idle until the next frame is due, so input is sampled right before it
+        // starts; OS events are still pumped to the input thread meanwhile
+        PROFILE_SCOPE("waitForNextFrame");
+        frameScheduler.waitForNextFrame();
+    }
+    
+    renderThread.stop();
+    gProfiler.stopCapture();
+    
+    if (gFrameStats.isEnabled()) {
+        gFrameStats.flush();
+        gFrameStats.report(std::cout);
+        if (gFrameStats.writeCsv("frame_stats.csv")) {
+            std::cout << "Frame statistics written to frame_stats.csv" << std::endl;
+        }
+        Memory::report(std::cout);
+    }
+    inputRecorder.stop();
+    inputThread.stop();
+    Threading::Jobs.stop();
+    
+    if (headless || frameLimit > 0) {
+        printRunSummary();
+    }
+    if (gLatencyTracer.isEnabled()) {
+        gLatencyTracer.report(std::cout);
     }
     
     // Shutdown the audio mixer when the app stops running
@@ -83,51 +203,193 @@ void App::run() {
     ShutdownPiano();
 }
 
+void App::exportFrameGraph(const std::string& path) {
+    frameGraph.requestExport(path);
+}
+
+void App::printRunSummary() const {
+    if (frameIndex == 0) {
+        return;
+    }
+    
+    double elapsedSeconds = static_cast<double>(SDL_GetTicksNS() - runStartNs) / SDL_NS_PER_SECOND;
+    std::cout << std::fixed << std::setprecision(3)
+              << "Ran " << frameIndex << " frames in " << elapsedSeconds << " s ("
+              << static_cast<double>(frameIndex) / elapsedSeconds << " fps)\n"
+              << "Frame work (ms): avg " << frameWorkTotalNs / 1e6 / static_cast<double>(frameIndex)
+              << ", min " << frameWorkMinNs / 1e6
+              << ", max " << frameWorkMaxNs / 1e6 << "\n"
+              << "Dropped simulation steps: " << frameScheduler.getDroppedSteps() << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+bool App::startInputRecording(const std::string& path) {
+    return inputRecorder.start(path, frameIndex);
+}
+
+bool App::startInputReplay(const std::string& path, ReplayMode mode, bool quitWhenFinished) {
+    if (!inputReplayer.load(path)) {
+        return false;
+    }
+    inputReplayer.start(frameIndex, mode);
+    inputThread.setLiveInputEnabled(false);
+    quitAfterReplay = quitWhenFinished;
+    return true;
+}
+
 void App::processEvents() {
+    PROFILE_SCOPE("App::processEvents");
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_EVENT_QUIT) {
-            running = false;
+        // Live input is ignored while a replay drives the session, except
+        // QUIT: closing the window still ends a replay early
+        if (inputReplayer.isActive() && event.type != SDL_EVENT_QUIT && InputRecorder::isRecordable(event.type)) {
+            continue;
         }
-        // Handle window events
-        else if (event.type == SDL_EVENT_WINDOW_RESIZED) {
-            // Get the new window size
-            int newWidth, newHeight;
-            SDL_GetWindowSizeInPixels(window, &newWidth, &newHeight);
-            
-            // Update the stored dimensions
-            width = newWidth;
-            height = newHeight;
-            
-            // Let the renderer know about the resize
-            if (renderer) {
-                renderer->handleWindowResize(width, height);
+        dispatchEvent(event);
+    }
+    
+    // Feed the replayed events that are due this frame
+    if (inputReplayer.isActive()) {
+        while (inputReplayer.nextEvent(frameIndex, event)) {
+            inputThread.submit(event);
+            dispatchEvent(event);
+        }
+        if (inputReplayer.isFinished()) {
+            std::cout << "Input replay finished after " << frameIndex << " frames" << std::endl;
+            inputReplayer.stop();
+            inputThread.setLiveInputEnabled(true);
+            if (quitAfterReplay) {
+                running = false;
             }
         }
+    }
+}
+
+void App::dispatchEvent(const SDL_Event& event) {
+    inputRecorder.record(event, frameIndex);
+    gLatencyTracer.onFrameEvent(event);
+    
+    if (event.type == SDL_EVENT_QUIT) {
+        running = false;
+    }
+    // Handle window events
+    else if (event.type == SDL_EVENT_WINDOW_RESIZED) {
+        // Get the new window size
+        int newWidth, newHeight;
+        SDL_GetWindowSizeInPixels(window, &newWidth, &newHeight);
+        
+        // Update the stored dimensions
+        width = newWidth;
+        height = newHeight;
+        
+        // The renderer recreates its swapchain when it draws this frame
+        windowResized = true;
+    }
+    // Audio device hot-plug and format changes go to the mixer
+    else if (event.type == SDL_EVENT_AUDIO_DEVICE_ADDED ||
+             event.type == SDL_EVENT_AUDIO_DEVICE_REMOVED ||
+             event.type == SDL_EVENT_AUDIO_DEVICE_FORMAT_CHANGED) {
+        if (gAudioMixer) {
+            gAudioMixer->HandleDeviceEvent(event);
+        }
+    }
+    
+    // Process keyboard input through your input system
+    // Only pass relevant keyboard events to the keyboard manager
+    if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) {
+        // Send events to the generic keyboard manager
+        Keyboard::Input.handleEvent(event);
         
-        // Process keyboard input through your input system
-        // Only pass relevant keyboard events to the keyboard manager
-        if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) {
-            // Send events to the generic keyboard manager
-            Keyboard::Input.handleEvent(event);
-            
-            // Also send them to the piano system
-            if (gPiano) {
-                gPiano->handleKeyEvent(event);
-            }
+        // Piano notes arrive through the input thread; recording controls stay here
+        if (gPiano) {
+            gPiano->handleControlEvent(event);
         }
     }
+    // Mouse buttons and gamepads drive actions too
+    else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_UP ||
+             (event.type >= SDL_EVENT_GAMEPAD_AXIS_MOTION && event.type <= SDL_EVENT_GAMEPAD_REMOVED)) {
+        Keyboard::Input.handleEvent(event);
+    }
+}
+
+void App::buildFrameGraph() {
+    // Systems touching the same resource run in the order they are added here;
+    // the input chain and the audio chain are independent and run side by side
+    frameGraph.addSystem("input", {}, {"input state"}, []() {
+        Keyboard::Input.update();
+    });
+    frameGraph.addSystem("combos", {"input state"}, {"combo state"}, []() {
+        Keyboard::Combos.update();
+    });
+    
+    // Game logic advances at the simulation rate, independent of the frame rate
+    frameGraph.addSystem("simulation", {"input state", "combo state"}, {"game state"}, [this]() {
+        while (frameScheduler.consumeFixedStep()) {
+            fixedUpdate(frameScheduler.getFixedDeltaSeconds());
+        }
+    });
+    
+    // Piano playback queues notes that the mixer then tracks for fade-outs
+    frameGraph.addSystem("piano", {}, {"audio commands"}, [this]() {
+        uint64_t startNs = SDL_GetTicksNS();
+        if (gPiano) {
+            gPiano->update();
+        }
+        gFrameStats.addTime(frameIndex, FramePhase::Audio, SDL_GetTicksNS() - startNs);
+    });
+    frameGraph.addSystem("audio mixer", {"audio commands"}, {"audio channels"}, [this]() {
+        uint64_t startNs = SDL_GetTicksNS();
+        if (gAudioMixer) {
+            gAudioMixer->Update();
+        }
+        gFrameStats.addTime(frameIndex, FramePhase::Audio, SDL_GetTicksNS() - startNs);
+    });
 }
 
 void App::update() {
-    // Update input state
-    Keyboard::Input.update();
+    PROFILE_SCOPE("App::update");
+    frameGraph.execute(Threading::Jobs);
+    
+    gLatencyTracer.onFrameStage(LatencyStage::Update);
+}
+
+void App::fixedUpdate(double deltaSeconds) {
+    (void)deltaSeconds;
     
     // Add game logic updates here
     // This is where you would update game state, physics, etc.
 }
 
 void App::render() {
-    // Let the renderer draw the current frame
-    renderer->drawFrame();
+    PROFILE_SCOPE("App::render");
+    // Capture what the renderer needs; moving objects should be captured at
+    // frameScheduler.getInterpolationAlpha() between their last two fixed steps
+    RenderSnapshot snapshot;
+    snapshot.frameIndex = frameIndex;
+    snapshot.interpolationAlpha = frameScheduler.getInterpolationAlpha();
+    snapshot.windowResized = windowResized;
+    snapshot.width = width;
+    snapshot.height = height;
+    gLatencyTracer.takeFrameEvents(snapshot.latencyEvents);
+    windowResized = false;
+    
+    if (!renderer) {
+        return; // headless
+    }
+    if (renderThread.isRunning()) {
+        renderThread.submit(snapshot);
+    } else {
+        drawSnapshot(snapshot);
+    }
+}
+
+void App::drawSnapshot(const RenderSnapshot& snapshot) {
+    PROFILE_SCOPE("Renderer::drawFrame");
+    uint64_t startNs = SDL_GetTicksNS();
+    if (snapshot.windowResized) {
+        renderer->handleWindowResize(snapshot.width, snapshot.height);
+    }
+    renderer->drawFrame(snapshot);
+    gFrameStats.addTime(snapshot.frameIndex, FramePhase::Render, SDL_GetTicksNS() - startNs);
 }
\ No newline at end of file
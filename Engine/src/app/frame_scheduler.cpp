@@ -0,0 +1,138 @@
+#include <app/frame_scheduler.hpp>
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+    constexpr uint64_t OVERSLEEP_SAMPLE_WINDOW = 1000;
+    // OS events are pumped at least this often while the frame is idle, so the
+    // input thread's listeners don't wait for the next frame to see them
+    constexpr uint64_t EVENT_PUMP_INTERVAL_NS = 1000000;
+}
+
+void FrameScheduler::configure(int maxFPS, int simulationHz) {
+    framePeriodNs = maxFPS > 0 ? SDL_NS_PER_SECOND / static_cast<uint64_t>(maxFPS) : 0;
+    fixedStepNs = SDL_NS_PER_SECOND / static_cast<uint64_t>(std::max(simulationHz, 1));
+
+    frameStartNs = 0;
+    nextFrameNs = 0;
+    accumulatorNs = 0;
+    smoothingDriftNs = 0;
+    recentCount = 0;
+}
+
+void FrameScheduler::beginFrame() {
+    uint64_t now = SDL_GetTicksNS();
+    if (frameStartNs == 0) {
+        // First frame: one step's worth of time so the simulation starts right away
+        frameStartNs = now - fixedStepNs;
+        nextFrameNs = now;
+    }
+
+    frameDeltaNs = std::min(now - frameStartNs, MAX_FRAME_DELTA_NS);
+    frameStartNs = now;
+
+    // The simulation runs on the average of the last few deltas, so a single
+    // late frame doesn't turn into a burst of steps followed by an empty frame
+    recentDeltas[recentCount % SMOOTHING_FRAMES] = frameDeltaNs;
+    recentCount++;
+    size_t samples = std::min(recentCount, SMOOTHING_FRAMES);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < samples; i++) {
+        sum += recentDeltas[i];
+    }
+    smoothedDeltaNs = sum / samples;
+
+    // Smoothing must not lose time: once the difference exceeds a step it is paid back
+    smoothingDriftNs += static_cast<int64_t>(frameDeltaNs) - static_cast<int64_t>(smoothedDeltaNs);
+    uint64_t simulatedNs = smoothedDeltaNs;
+    if (smoothingDriftNs > static_cast<int64_t>(fixedStepNs) || -smoothingDriftNs > static_cast<int64_t>(fixedStepNs)) {
+        simulatedNs = static_cast<uint64_t>(std::max<int64_t>(0, static_cast<int64_t>(simulatedNs) + smoothingDriftNs));
+        smoothingDriftNs = 0;
+    }
+
+    accumulatorNs += simulatedNs;
+    stepsThisFrame = 0;
+}
+
+bool FrameScheduler::consumeFixedStep() {
+    if (accumulatorNs < fixedStepNs) {
+        return false;
+    }
+
+    if (stepsThisFrame >= MAX_STEPS_PER_FRAME) {
+        // Too far behind to catch up: drop the backlog rather than spiral
+        droppedSteps += accumulatorNs / fixedStepNs;
+        accumulatorNs %= fixedStepNs;
+        return false;
+    }
+
+    accumulatorNs -= fixedStepNs;
+    stepsThisFrame++;
+    return true;
+}
+
+float FrameScheduler::getInterpolationAlpha() const {
+    return static_cast<float>(static_cast<double>(accumulatorNs) / static_cast<double>(fixedStepNs));
+}
+
+void FrameScheduler::waitForNextFrame() {
+    if (framePeriodNs == 0) {
+        return;
+    }
+
+    // Deadlines advance by whole periods so the rate doesn't drift; after a
+    // long frame the schedule restarts instead of rushing to catch up
+    nextFrameNs += framePeriodNs;
+    uint64_t now = SDL_GetTicksNS();
+    if (now >= nextFrameNs) {
+        if (now - nextFrameNs > framePeriodNs) {
+            nextFrameNs = now;
+        }
+        return;
+    }
+
+    sleepUntil(nextFrameNs);
+}
+
+void FrameScheduler::sleepUntil(uint64_t deadlineNs) {
+    // Sleep for the wait minus the usual oversleep (mean plus one deviation)
+    uint64_t now = SDL_GetTicksNS();
+    if (now >= deadlineNs) {
+        return; // passed while we were preempted; the wait below would wrap
+    }
+    double marginNs = std::max(0.0, oversleepMeanNs + std::sqrt(oversleepSamples > 1 ? oversleepM2 / (oversleepSamples - 1) : 0.0));
+    uint64_t wakeNs = static_cast<double>(deadlineNs - now) > marginNs ? deadlineNs - static_cast<uint64_t>(marginNs) : now;
+
+    // Sleep in slices, pumping events between them, until one slice is left
+    while (wakeNs > now && wakeNs - now > EVENT_PUMP_INTERVAL_NS) {
+        SDL_DelayNS(EVENT_PUMP_INTERVAL_NS);
+        SDL_PumpEvents();
+        now = SDL_GetTicksNS();
+    }
+
+    // Only the last sleep is measured: it alone has to land on the margin
+    if (wakeNs > now) {
+        uint64_t requestedNs = wakeNs - now;
+        SDL_DelayNS(requestedNs);
+        uint64_t woke = SDL_GetTicksNS();
+        double oversleepNs = static_cast<double>(woke - now) - static_cast<double>(requestedNs);
+
+        if (oversleepSamples < OVERSLEEP_SAMPLE_WINDOW) {
+            oversleepSamples++;
+        }
+        double delta = oversleepNs - oversleepMeanNs;
+        oversleepMeanNs += delta / static_cast<double>(oversleepSamples);
+        oversleepM2 += delta * (oversleepNs - oversleepMeanNs);
+        if (oversleepSamples == OVERSLEEP_SAMPLE_WINDOW) {
+            // Forget old samples at the same rate the mean does
+            oversleepM2 *= static_cast<double>(OVERSLEEP_SAMPLE_WINDOW - 1) / OVERSLEEP_SAMPLE_WINDOW;
+        }
+    }
+
+    // Spin out the remainder
+    while (SDL_GetTicksNS() < deadlineNs) {
+        std::this_thread::yield();
+    }
+}
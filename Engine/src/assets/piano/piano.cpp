@@ -1,14 +1,18 @@
 #include <assets/piano/piano.hpp>
 #include <audio/mixer.hpp>
 #include <audio/audio.hpp>
-#include <iostream>
+#include <profiling/latency_tracer.hpp>
+#include <memory/memory_tracker.hpp>
+#include <logging/logger.hpp>
 #include <fstream>
 
 // Global piano instance
 Piano* gPiano = nullptr;
 
-Piano::Piano() : sustainMode(false), recording(false), playing(false), recordStartTime(0), playbackIndex(0) {
-    initializeNoteFrequencies();
+Piano::Piano() : tuningSystem(TuningSystem::EqualTemperament),
+                 referenceA4(Notes::DEFAULT_A4_FREQUENCY), sustainMode(false), recording(false), playing(false),
+                 recordStartTime(0), playbackIndex(0) {
+    storeFrequencies(Notes::EQUAL_TEMPERAMENT_440);
     initializeKeyMappings();
 }
 
@@ -22,11 +26,14 @@ bool Piano::initialize() {
         InitializeAudioMixer();
     }
     
-    std::cout << "Piano system initialized" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Piano system initialized");
     return true;
 }
 
 void Piano::update() {
+    MEMORY_TAG_SCOPE(Memory::Tag::Assets);
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    
     // Handle playback of recorded notes if we're in playback mode
     if (playing && !recordedNotes.empty()) {
         uint64_t currentTime = SDL_GetTicks();
@@ -48,63 +55,92 @@ void Piano::update() {
         // Check if we've finished playback
         if (playbackIndex >= recordedNotes.size()) {
             playing = false;
-            std::cout << "Playback finished" << std::endl;
+            LOG_INFO(Log::Category::Audio, "Playback finished");
         }
-    } else {
-        SDL_Delay(10); // Small delay for the update loop when idle
     }
 }
 
 void Piano::handleKeyEvent(const SDL_Event& event) {
-    if (event.type == SDL_EVENT_KEY_DOWN) {
-        SDL_Keycode key = event.key.key;
-        
-        // Recording control - 'S' to save recording
-        if (key == SDLK_S) {
-            saveRecording();
-            return;
-        }
+    handleControlEvent(event);
+    handleNoteEvent(event);
+}
+
+void Piano::handleControlEvent(const SDL_Event& event) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Assets);
+    if (event.type != SDL_EVENT_KEY_DOWN) {
+        return;
+    }
+    
+    // Recording control - 'S' to save recording
+    if (event.key.key == SDLK_S) {
+        saveRecording();
+    }
+    // Playback control - 'D' to play recording
+    else if (event.key.key == SDLK_D) {
+        playRecording();
+    }
+}
+
+void Piano::handleNoteEvent(const SDL_Event& event) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Assets);
+    if (event.type != SDL_EVENT_KEY_DOWN) {
+        return;
+    }
+    
+    // Check if this key is mapped to a piano note
+    SDL_Keycode key = event.key.key;
+    int mappedNote = (key < KEY_TABLE_SIZE) ? keyToNoteMap[key] : -1;
+    if (mappedNote < 0) {
+        return;
+    }
+    
+    NoteId note = static_cast<NoteId>(mappedNote);
+    {
+        LatencyTracer::SoundScope trace(event);
+        playNote(note);
+    }
+    
+    // Record the note if we're in recording mode, using the time the key went
+    // down rather than the time the event was handled
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    if (recording) {
+        uint64_t eventTime = event.common.timestamp ? SDL_NS_TO_MS(event.common.timestamp) : SDL_GetTicks();
+        uint64_t relativeTime = eventTime > recordStartTime ? eventTime - recordStartTime : 0;
         
-        // Playback control - 'D' to play recording
-        if (key == SDLK_D) {
-            playRecording();
-            return;
-        }
+        NoteRecord record;
+        record.note = note;
+        record.duration = 1000; // Default duration
+        record.timestamp = relativeTime;
         
-        // Check if this key is mapped to a piano note
-        auto noteIt = keyToNoteMap.find(key);
-        if (noteIt != keyToNoteMap.end()) {
-            std::string note = noteIt->second;
-            playNote(note);
-            
-            // Record the note if we're in recording mode
-            if (recording) {
-                uint64_t currentTime = SDL_GetTicks();
-                uint64_t relativeTime = currentTime - recordStartTime;
-                
-                NoteRecord record;
-                record.note = note;
-                record.duration = 1000; // Default duration
-                record.timestamp = relativeTime;
-                
-                recordedNotes.push_back(record);
-                std::cout << "Recorded note: " << note << " at time: " << relativeTime << "ms" << std::endl;
-            }
-        }
+        recordedNotes.push_back(record);
+        LOG_INFO(Log::Category::Audio, "Recorded note: {}{} at time: {}ms",
+                 Notes::pitchClassName(note), Notes::octaveOf(note), relativeTime);
     }
 }
 
-void Piano::playNote(const std::string& note, int durationMs) {
-    auto freqIt = noteFrequencies.find(note);
-    if (freqIt != noteFrequencies.end()) {
-        float frequency = freqIt->second;
-        
-        // Use the audio mixer to play the note
-        if (gAudioMixer) {
-            gAudioMixer->PlaySound(frequency, durationMs);
-            std::cout << "Playing note " << note << " at " << frequency << "Hz" << std::endl;
-        }
+void Piano::playNote(NoteId note, int durationMs) {
+    if (note >= Notes::NOTE_COUNT) {
+        return;
     }
+    
+    gLatencyTracer.onSoundStage(LatencyTracer::currentSoundTrace(), LatencyStage::PlayNote);
+    float frequency = noteFrequencies[note].load(std::memory_order_relaxed);
+    
+    // Use the audio mixer to play the note
+    if (gAudioMixer) {
+        gAudioMixer->PlayNote(note, frequency, durationMs);
+        LOG_INFO(Log::Category::Audio, "Playing note {}{} at {}Hz",
+                 Notes::pitchClassName(note), Notes::octaveOf(note), frequency);
+    }
+}
+
+void Piano::playNote(const std::string& noteName, int durationMs) {
+    int note = Notes::noteIdFromName(noteName);
+    if (note < 0) {
+        LOG_ERROR(Log::Category::Audio, "Unknown note '{}'", noteName);
+        return;
+    }
+    playNote(static_cast<NoteId>(note), durationMs);
 }
 
 void Piano::toggleSustainMode() {
@@ -115,7 +151,7 @@ void Piano::toggleSustainMode() {
         gAudioMixer->ToggleSustainMode();
     }
     
-    std::cout << "Sustain mode: " << (sustainMode ? "ON" : "OFF") << std::endl;
+    LOG_INFO(Log::Category::Audio, "Sustain mode: {}", sustainMode ? "ON" : "OFF");
 }
 
 void Piano::stopAllNotes() {
@@ -128,96 +164,119 @@ bool Piano::isSustainModeEnabled() const {
     return sustainMode;
 }
 
+void Piano::setTuning(TuningSystem system, float a4Frequency) {
+    tuningSystem = system;
+    referenceA4 = a4Frequency;
+    storeFrequencies(Notes::makeFrequencyTable(Notes::ratiosFor(system), a4Frequency));
+    
+    LOG_INFO(Log::Category::Audio, "Tuning set to {} (A4 = {}Hz)",
+             system == TuningSystem::JustIntonation ? "just intonation" : "equal temperament", a4Frequency);
+}
+
+TuningSystem Piano::getTuningSystem() const {
+    return tuningSystem;
+}
+
+float Piano::getNoteFrequency(NoteId note) const {
+    return note < Notes::NOTE_COUNT ? noteFrequencies[note].load(std::memory_order_relaxed) : 0.0f;
+}
+
+void Piano::storeFrequencies(const Notes::FrequencyTable& frequencies) {
+    // One frequency is all a note reads, so per-entry atomics are enough
+    for (size_t note = 0; note < frequencies.size(); note++) {
+        noteFrequencies[note].store(frequencies[note], std::memory_order_relaxed);
+    }
+}
+
 void Piano::startRecording() {
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    startRecordingLocked();
+}
+
+void Piano::stopRecording() {
+    std::lock_guard<std::mutex> lock(recordingMutex);
+    stopRecordingLocked();
+}
+
+void Piano::startRecordingLocked() {
     // Clear previous recording
     recordedNotes.clear();
     recording = true;
     recordStartTime = SDL_GetTicks();
-    std::cout << "Recording started" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Recording started");
 }
 
-void Piano::stopRecording() {
+void Piano::stopRecordingLocked() {
     if (recording) {
         recording = false;
-        std::cout << "Recording stopped (" << recordedNotes.size() << " notes recorded)" << std::endl;
+        LOG_INFO(Log::Category::Audio, "Recording stopped ({} notes recorded)", recordedNotes.size());
     }
 }
 
 void Piano::saveRecording() {
+    std::lock_guard<std::mutex> lock(recordingMutex);
     if (recording) {
-        stopRecording(); // Stop recording if currently active
+        stopRecordingLocked(); // Stop recording if currently active
     }
     
     if (recordedNotes.empty()) {
-        std::cout << "No notes to save" << std::endl;
-        startRecording(); // Start new recording
+        LOG_INFO(Log::Category::Audio, "No notes to save");
+        startRecordingLocked(); // Start new recording
         return;
     }
     
-    std::cout << "Recording saved with " << recordedNotes.size() << " notes" << std::endl;
-    std::cout << "Press 'D' to play back the recording" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Recording saved with {} notes", recordedNotes.size());
+    LOG_INFO(Log::Category::Audio, "Press 'D' to play back the recording");
     
-    startRecording(); // Start a new recording session
+    startRecordingLocked(); // Start a new recording session
 }
 
 void Piano::playRecording() {
+    std::lock_guard<std::mutex> lock(recordingMutex);
     if (recordedNotes.empty()) {
-        std::cout << "No recording to play" << std::endl;
+        LOG_INFO(Log::Category::Audio, "No recording to play");
         return;
     }
     
     if (recording) {
-        stopRecording(); // Stop recording if we're currently recording
+        stopRecordingLocked(); // Stop recording if we're currently recording
     }
     
     playing = true;
     playbackIndex = 0;
     recordStartTime = SDL_GetTicks(); // Reset the start time for playback
-    std::cout << "Playing back recording with " << recordedNotes.size() << " notes" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Playing back recording with {} notes", recordedNotes.size());
 }
 
 bool Piano::isRecording() const {
+    std::lock_guard<std::mutex> lock(recordingMutex);
     return recording;
 }
 
 bool Piano::isPlaying() const {
+    std::lock_guard<std::mutex> lock(recordingMutex);
     return playing;
 }
 
-void Piano::initializeNoteFrequencies() {
-    // Initialize musical note frequencies (using standard A4 = 440Hz as reference)
-    noteFrequencies = {
-        {"C4", 261.63f},  // C4
-        {"D4", 293.66f},  // D4
-        {"E4", 329.63f},  // E4
-        {"F4", 349.23f},  // F4
-        {"G4", 392.00f},  // G4
-        {"A4", 440.00f},  // A4
-        {"B4", 493.88f},  // B4
-        {"C5", 523.25f},  // C5
-        {"D5", 587.33f},  // D5
-        {"E5", 659.25f}   // E5
-    };
-}
-
 void Piano::initializeKeyMappings() {
+    keyToNoteMap.fill(-1);
+    
     // Map keyboard keys to notes
-    keyToNoteMap = {
-        {SDLK_Q, "C4"},  // Q -> C4
-        {SDLK_W, "D4"},  // W -> D4
-        {SDLK_E, "E4"},  // E -> E4
-        {SDLK_R, "F4"},  // R -> F4
-        {SDLK_T, "G4"},  // T -> G4
-        {SDLK_Z, "A4"},  // Z -> A4
-        {SDLK_U, "B4"},  // U -> B4
-        {SDLK_I, "C5"},  // I -> C5
-        {SDLK_O, "D5"},  // O -> D5
-        {SDLK_P, "E5"}   // P -> E5
-    };
+    keyToNoteMap[SDLK_Q] = Notes::noteIdFromName("C4");  // Q -> C4
+    keyToNoteMap[SDLK_W] = Notes::noteIdFromName("D4");  // W -> D4
+    keyToNoteMap[SDLK_E] = Notes::noteIdFromName("E4");  // E -> E4
+    keyToNoteMap[SDLK_R] = Notes::noteIdFromName("F4");  // R -> F4
+    keyToNoteMap[SDLK_T] = Notes::noteIdFromName("G4");  // T -> G4
+    keyToNoteMap[SDLK_Z] = Notes::noteIdFromName("A4");  // Z -> A4
+    keyToNoteMap[SDLK_U] = Notes::noteIdFromName("B4");  // U -> B4
+    keyToNoteMap[SDLK_I] = Notes::noteIdFromName("C5");  // I -> C5
+    keyToNoteMap[SDLK_O] = Notes::noteIdFromName("D5");  // O -> D5
+    keyToNoteMap[SDLK_P] = Notes::noteIdFromName("E5");  // P -> E5
 }
 
 // Global helper functions
 void InitializePiano() {
+    MEMORY_TAG_SCOPE(Memory::Tag::Assets);
     if (!gPiano) {
         gPiano = new Piano();
         gPiano->initialize();
@@ -1,6 +1,5 @@
 #include <audio/audio.hpp>
 #include <SDL3/SDL.h>
-#include <iostream>
 #include <cmath>
 #include <thread>
 #include <mutex>
@@ -9,16 +8,22 @@
 #include <map>
 #include <inputs/keyboard.hpp>  // Add this include
 #include <audio/mixer.hpp>
+#include <threading/threading.hpp>
+#include <profiling/latency_tracer.hpp>
+#include <memory/memory_tracker.hpp>
+#include <memory/frame_arena.hpp>
+#include <logging/logger.hpp>
 
 // Define M_PI if not already defined
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-AudioSystem::AudioSystem() : audioDeviceID(0), audioStream(nullptr), sampleRate(48000), frequency(440.0f), isPlaying(false), fadeSamples(1000) {
-    // Add default sine wave component
+AudioSystem::AudioSystem(int rate) : audioDeviceID(0), ownsDevice(false), audioStream(nullptr), sampleRate(rate), frequency(440.0f), isPlaying(false), fadeSamples(rate / 48),
+                                     latencyTrace(0), pendingLatencyTrace(0), leadInBytes(0), deviceBufferNs(0) {
+    // Add default sine wave component; the waveform itself is generated on first use
+    // so channels that load their own components or cached data don't pay for it
     AddWaveComponent(WaveType::Sine, frequency, 0.2f);
-    GenerateComplexWave();
 }
 
 AudioSystem::~AudioSystem() {
@@ -26,11 +31,26 @@ AudioSystem::~AudioSystem() {
     if (audioStream) {
         SDL_DestroyAudioStream(audioStream);
     }
-    if (audioDeviceID > 0) {
+    if (audioDeviceID > 0 && ownsDevice) {
         SDL_CloseAudioDevice(audioDeviceID);
     }
 }
 
+namespace {
+    // PolyBLEP residual that smooths a unit step at cycle position 0
+    double PolyBlep(double t, double dt) {
+        if (t < dt) {
+            t /= dt;
+            return t + t - t * t - 1.0;
+        }
+        if (t > 1.0 - dt) {
+            t = (t - 1.0) / dt;
+            return t * t + t + t + 1.0;
+        }
+        return 0.0;
+    }
+}
+
 // Generate a simple sine wave
 void AudioSystem::GenerateSineWave() {
     // 1 second of audio with additional space for fade in/out
@@ -68,6 +88,29 @@ float AudioSystem::GenerateWaveSample(WaveType type, float phase, float amplitud
     }
 }
 
+float AudioSystem::GenerateBandLimitedSample(WaveType type, double cycle, double cycleStep, float amplitude) {
+    switch (type) {
+        case WaveType::Square: {
+            // Same phase as the naive square: high for the first half cycle
+            double value = cycle < 0.5 ? 1.0 : -1.0;
+            value += PolyBlep(cycle, cycleStep);
+            value -= PolyBlep(std::fmod(cycle + 0.5, 1.0), cycleStep);
+            return static_cast<float>(value) * amplitude;
+        }
+        
+        case WaveType::Sawtooth: {
+            // Same phase as the naive sawtooth: wraps at half cycle
+            double shifted = std::fmod(cycle + 0.5, 1.0);
+            double value = 2.0 * shifted - 1.0 - PolyBlep(shifted, cycleStep);
+            return static_cast<float>(value) * amplitude;
+        }
+        
+        default:
+            // Sine is band-limited already, triangle harmonics fall off fast enough
+            return GenerateWaveSample(type, static_cast<float>(2.0 * M_PI * cycle), amplitude);
+    }
+}
+
 void AudioSystem::AddWaveComponent(WaveType type, float freq, float amplitude) {
     WaveComponent component{type, freq, amplitude};
     waveComponents.push_back(component);
@@ -132,9 +175,34 @@ void AudioSystem::GenerateComplexWave() {
     ApplyFades();
 }
 
-bool AudioSystem::Initialize() {
+void AudioSystem::GenerateBandLimitedWave() {
+    if (waveComponents.empty()) {
+        GenerateSineWave();
+        return;
+    }
+    
+    sineWaveData.assign(sampleRate, 0.0f);
+    float normalizer = 1.0f / waveComponents.size();
+    
+    for (int i = 0; i < sampleRate; i++) {
+        float sample = 0.0f;
+        
+        for (const auto& comp : waveComponents) {
+            double cycleStep = comp.frequency / sampleRate;
+            double cycles = cycleStep * i;
+            sample += GenerateBandLimitedSample(comp.type, cycles - std::floor(cycles), cycleStep, comp.amplitude);
+        }
+        
+        sineWaveData[i] = sample * normalizer;
+    }
+    
+    ApplyFades();
+}
+
+bool AudioSystem::Initialize(SDL_AudioDeviceID outputDevice) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     if (!SDL_Init(SDL_INIT_AUDIO)) {
-        std::cerr << "Failed to initialize SDL audio: " << SDL_GetError() << std::endl;
+        LOG_ERROR(Log::Category::Audio, "Failed to initialize SDL audio: {}", SDL_GetError());
         return false;
     }
     
@@ -144,57 +212,93 @@ bool AudioSystem::Initialize() {
     audioSpec.format = SDL_AUDIO_F32;
     audioSpec.channels = 1;
     
-    // Open audio device with the default playback device
-    audioDeviceID = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &audioSpec);
-    if (audioDeviceID == 0) {
-        std::cerr << "Failed to open audio device: " << SDL_GetError() << std::endl;
-        return false;
+    if (outputDevice != 0) {
+        // Share the mixer's device; SDL mixes all streams bound to it
+        audioDeviceID = outputDevice;
+        ownsDevice = false;
+    } else {
+        // Open audio device with the default playback device
+        audioDeviceID = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &audioSpec);
+        if (audioDeviceID == 0) {
+            LOG_ERROR(Log::Category::Audio, "Failed to open audio device: {}", SDL_GetError());
+            return false;
+        }
+        ownsDevice = true;
     }
     
-    // Create audio stream
-    audioStream = SDL_CreateAudioStream(&audioSpec, &audioSpec);
+    // Create audio stream (the output side is set by the device when bound)
+    audioStream = SDL_CreateAudioStream(&audioSpec, nullptr);
     if (!audioStream) {
-        std::cerr << "Failed to create audio stream: " << SDL_GetError() << std::endl;
-        SDL_CloseAudioDevice(audioDeviceID);
+        LOG_ERROR(Log::Category::Audio, "Failed to create audio stream: {}", SDL_GetError());
+        if (ownsDevice) SDL_CloseAudioDevice(audioDeviceID);
+        audioDeviceID = 0;
         return false;
     }
     
     // Bind the stream to the device
     if (!SDL_BindAudioStream(audioDeviceID, audioStream)) {
-        std::cerr << "Failed to bind audio stream: " << SDL_GetError() << std::endl;
+        LOG_ERROR(Log::Category::Audio, "Failed to bind audio stream: {}", SDL_GetError());
         SDL_DestroyAudioStream(audioStream);
-        SDL_CloseAudioDevice(audioDeviceID);
+        audioStream = nullptr;
+        if (ownsDevice) SDL_CloseAudioDevice(audioDeviceID);
+        audioDeviceID = 0;
         return false;
     }
     
     // Before playing any sound, clear the audio buffer
     SDL_ClearAudioStream(audioStream);
     
-    std::cout << "Audio system initialized successfully!" << std::endl;
+    // A block mixed by the device plays after the one already queued
+    SDL_AudioSpec deviceSpec;
+    int deviceFrames = 0;
+    if (SDL_GetAudioDeviceFormat(audioDeviceID, &deviceSpec, &deviceFrames) && deviceSpec.freq > 0) {
+        deviceBufferNs = SDL_SECONDS_TO_NS(static_cast<uint64_t>(deviceFrames)) / deviceSpec.freq;
+    }
+    
+    LOG_INFO(Log::Category::Audio, "Audio system initialized successfully!");
     return true;
 }
 
 void AudioSystem::PlaySound() {
+    if (sineWaveData.empty()) {
+        GenerateComplexWave();
+    }
+    PlaySound(sineWaveData);
+}
+
+void AudioSystem::PlaySound(const std::vector<float>& waveData) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     if (audioDeviceID > 0 && audioStream) {
+        // Hold the stream so the device cannot pull between the puts below
+        SDL_LockAudioStream(audioStream);
+        
         // Clear any previous data in the stream
         SDL_ClearAudioStream(audioStream);
         
         // Add 50ms of silence before the actual sound to ensure clean start
-        std::vector<float> silenceBuffer(sampleRate / 20, 0.0f);
+        Memory::ScratchScope scratchScope;
+        Memory::ScratchVector<float> silenceBuffer(sampleRate / 20, 0.0f);
         SDL_PutAudioStreamData(audioStream, silenceBuffer.data(), static_cast<int>(silenceBuffer.size() * sizeof(float)));
         
-        // Put the sine wave data into the stream
-        if (!SDL_PutAudioStreamData(audioStream, sineWaveData.data(), 
-                                   static_cast<int>(sineWaveData.size() * sizeof(float)))) {
-            std::cerr << "Failed to put audio data: " << SDL_GetError() << std::endl;
+        // Put the wave data into the stream
+        if (!SDL_PutAudioStreamData(audioStream, waveData.data(), 
+                                   static_cast<int>(waveData.size() * sizeof(float)))) {
+            LOG_ERROR(Log::Category::Audio, "Failed to put audio data: {}", SDL_GetError());
+            SDL_UnlockAudioStream(audioStream);
             return;
         }
         
         // Add 50ms of silence after the actual sound to ensure clean end
         SDL_PutAudioStreamData(audioStream, silenceBuffer.data(), static_cast<int>(silenceBuffer.size() * sizeof(float)));
         
+        // The traced sound becomes audible once the device has pulled the lead-in silence
+        latencyTrace = pendingLatencyTrace;
+        pendingLatencyTrace = 0;
+        leadInBytes = static_cast<int64_t>(silenceBuffer.size() * sizeof(float));
+        SDL_UnlockAudioStream(audioStream);
+        
         SDL_ResumeAudioDevice(audioDeviceID);
-        std::cout << "Playing sound..." << std::endl;
+        LOG_INFO(Log::Category::Audio, "Playing sound...");
     }
 }
 
@@ -204,9 +308,11 @@ void AudioSystem::StopSound() {
         // First clear the stream
         SDL_ClearAudioStream(audioStream);
         
-        // Then pause the device
-        SDL_PauseAudioDevice(audioDeviceID);
-        std::cout << "Sound stopped." << std::endl;
+        // Then pause the device (a shared device keeps running for other streams)
+        if (ownsDevice) {
+            SDL_PauseAudioDevice(audioDeviceID);
+        }
+        LOG_INFO(Log::Category::Audio, "Sound stopped.");
     }
 }
 
@@ -221,23 +327,102 @@ void AudioSystem::SetFrequency(float newFreq) {
     }
     
     GenerateComplexWave();
-    std::cout << "Frequency set to " << frequency << " Hz" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Frequency set to {} Hz", frequency);
 }
 
 bool AudioSystem::IsPlaying() const {
     return isPlaying;
 }
 
+const std::vector<float>& AudioSystem::GetWaveData() {
+    if (sineWaveData.empty()) {
+        GenerateComplexWave();
+    }
+    return sineWaveData;
+}
+
+void AudioSystem::SetOutputDevice(SDL_AudioDeviceID outputDevice) {
+    if (!audioStream || ownsDevice || outputDevice == audioDeviceID) {
+        return;
+    }
+    
+    // The old device may already be gone, in which case SDL has unbound the stream
+    SDL_UnbindAudioStream(audioStream);
+    audioDeviceID = outputDevice;
+    if (!SDL_BindAudioStream(audioDeviceID, audioStream)) {
+        LOG_ERROR(Log::Category::Audio, "Failed to rebind audio stream: {}", SDL_GetError());
+    }
+}
+
+void AudioSystem::SetSampleRate(int newSampleRate) {
+    if (newSampleRate <= 0 || newSampleRate == sampleRate) {
+        return;
+    }
+    
+    sampleRate = newSampleRate;
+    fadeSamples = sampleRate / 48;
+    
+    // Data queued before the change keeps its old format, so playback continues seamlessly
+    if (audioStream) {
+        audioSpec.freq = sampleRate;
+        SDL_SetAudioStreamFormat(audioStream, &audioSpec, nullptr);
+    }
+    
+    // The waveform is regenerated at the new rate by the next PlaySound or
+    // GetWaveData, not here: the mixer calls this for every live channel under
+    // its lock. clear() keeps the buffer's capacity for the regeneration.
+    sineWaveData.clear();
+}
+
+int AudioSystem::GetSampleRate() const {
+    return sampleRate;
+}
+
+void AudioSystem::SetLatencyTrace(uint32_t traceId) {
+    if (!audioStream || traceId == 0) {
+        return;
+    }
+    
+    // Registered on first use; untraced streams never pay for the callback
+    SDL_LockAudioStream(audioStream);
+    pendingLatencyTrace = traceId;
+    SDL_SetAudioStreamGetCallback(audioStream, StreamGetCallback, this);
+    SDL_UnlockAudioStream(audioStream);
+}
+
+void SDLCALL AudioSystem::StreamGetCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount) {
+    (void)stream;
+    (void)additionalAmount;
+    
+    // Runs on the device thread with the stream locked; totalAmount is in input bytes
+    AudioSystem* system = static_cast<AudioSystem*>(userdata);
+    if (system->latencyTrace == 0) {
+        return;
+    }
+    if (system->leadInBytes >= totalAmount) {
+        system->leadInBytes -= totalAmount;
+        return;
+    }
+    
+    // The first audible sample is in this block, after the remaining lead-in
+    uint64_t offsetFrames = static_cast<uint64_t>(system->leadInBytes) / sizeof(float);
+    uint64_t offsetNs = SDL_SECONDS_TO_NS(offsetFrames) / static_cast<uint64_t>(system->sampleRate);
+    gLatencyTracer.onSoundStage(system->latencyTrace, LatencyStage::FirstSample,
+                                SDL_GetTicksNS() + offsetNs + system->deviceBufferNs);
+    system->latencyTrace = 0;
+}
+
 void AudioSystem::PlaySoundAsync(int durationMs) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     // If a sound is already playing, don't start another one
     if (isPlaying.load()) {
-        std::cout << "Sound is already playing. Wait for it to finish." << std::endl;
+        LOG_INFO(Log::Category::Audio, "Sound is already playing. Wait for it to finish.");
         return;
     }
     
     // Start a new thread to play the sound
     isPlaying.store(true);
-    audioThread = std::thread([this, durationMs]() {
+    audioThread = Threading::createThread(Threading::configForRole(Threading::ThreadRole::Worker, "async sound"), [this, durationMs]() {
         this->PlaySound();
         
         // Sleep for the specified duration
@@ -245,19 +430,19 @@ void AudioSystem::PlaySoundAsync(int durationMs) {
         
         this->StopSound();
         this->isPlaying.store(false);
-        std::cout << "Async sound playback finished." << std::endl;
+        LOG_INFO(Log::Category::Audio, "Async sound playback finished.");
     });
     
     // Detach the thread to let it run independently
     audioThread.detach();
-    std::cout << "Started async sound playback for " << durationMs << " ms" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Started async sound playback for {} ms", durationMs);
 }
 
 void AudioSystem::StopAsyncSound() {
     if (isPlaying.load()) {
         StopSound();
         isPlaying.store(false);
-        std::cout << "Async sound playback stopped." << std::endl;
+        LOG_INFO(Log::Category::Audio, "Async sound playback stopped.");
     }
 }
 
@@ -268,10 +453,13 @@ void PlaySimpleSound() {
         InitializeAudioMixer();
     }
     
-    // Create a sample called "simpleSound"
-    gAudioMixer->AddSample("simpleSound", WaveType::Sine, 82.0f, 0.3f);
-    gAudioMixer->AddSample("simpleSound", WaveType::Sine, 164.0f, 0.15f);
-    gAudioMixer->AddSample("simpleSound", WaveType::Triangle, 123.0f, 0.8f);
+    // Create a sample called "simpleSound" (only once, it is cached afterwards)
+    if (!gAudioMixer->HasSample("simpleSound")) {
+        gAudioMixer->AddSample("simpleSound", WaveType::Sine, 82.0f, 0.3f);
+        gAudioMixer->AddSample("simpleSound", WaveType::Sine, 164.0f, 0.15f);
+        gAudioMixer->AddSample("simpleSound", WaveType::Triangle, 123.0f, 0.8f);
+        gAudioMixer->PrepareSample("simpleSound");
+    }
     
     // Play the sample
     gAudioMixer->PlaySample("simpleSound", 1000);
@@ -286,7 +474,7 @@ void PlaySimpleSoundAsync(int durationMs, float frequency) {
     
     // Play the sound with the given frequency and duration
     gAudioMixer->PlaySound(frequency, durationMs);
-    std::cout << "Playing simple sound async: " << frequency << "Hz for " << durationMs << "ms" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Playing simple sound async: {}Hz for {}ms", frequency, durationMs);
 }
 
 void ToggleSustainMode() {
@@ -305,5 +493,5 @@ void StopAllSounds() {
     }
     
     gAudioMixer->StopAllSounds();
-    std::cout << "All sounds stopped" << std::endl;
+    LOG_INFO(Log::Category::Audio, "All sounds stopped");
 }
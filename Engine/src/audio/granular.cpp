@@ -0,0 +1,339 @@
+#include <audio/granular.hpp>
+#include <SDL3/SDL.h>
+#include <logging/logger.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Define M_PI if not already defined
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    // Frames rendered per pass inside the stream callback
+    constexpr int RENDER_BLOCK_FRAMES = 1024;
+
+    // Hann-like window: sin^2(pi * p) using Bhaskara's sine approximation.
+    // Stays division-cheap and maps directly onto SIMD lanes.
+    inline float GrainWindow(float phase) {
+        if (phase < 0.0f || phase >= 1.0f) {
+            return 0.0f;
+        }
+        float x = 4.0f * phase * (1.0f - phase);
+        float s = 4.0f * x / (5.0f - x);
+        return s * s;
+    }
+}
+
+GranularVoice::GranularVoice()
+    : activeGrains(0), sampleRate(48000), sourceSampleRate(48000), samplesUntilNextGrain(0.0f), randomState(0x9E3779B9u),
+      audioStream(nullptr), ownsDevice(false), active(false) {
+    SDL_zero(streamSpec);
+}
+
+GranularVoice::~GranularVoice() {
+    if (audioStream) {
+        // Destroying a stream opened with SDL_OpenAudioDeviceStream also closes its device
+        SDL_DestroyAudioStream(audioStream);
+        audioStream = nullptr;
+    }
+}
+
+bool GranularVoice::Initialize(SDL_AudioDeviceID outputDevice, int rate) {
+    sampleRate = rate;
+
+    // Preallocate the mix buffers so the audio thread never allocates
+    mixLeft.resize(RENDER_BLOCK_FRAMES);
+    mixRight.resize(RENDER_BLOCK_FRAMES);
+    interleaved.resize(RENDER_BLOCK_FRAMES * 2);
+
+    if (!SDL_Init(SDL_INIT_AUDIO)) {
+        LOG_ERROR(Log::Category::Audio, "Failed to initialize SDL audio: {}", SDL_GetError());
+        return false;
+    }
+
+    streamSpec.freq = sampleRate;
+    streamSpec.format = SDL_AUDIO_F32;
+    streamSpec.channels = 2;
+
+    if (outputDevice == 0) {
+        // The device pulls audio from this voice on its own thread
+        audioStream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &streamSpec, StreamCallback, this);
+        ownsDevice = true;
+    } else {
+        // Pull through a stream bound to the shared device
+        audioStream = SDL_CreateAudioStream(&streamSpec, nullptr);
+        ownsDevice = false;
+        if (audioStream && (!SDL_SetAudioStreamGetCallback(audioStream, StreamCallback, this) ||
+                            !SDL_BindAudioStream(outputDevice, audioStream))) {
+            SDL_DestroyAudioStream(audioStream);
+            audioStream = nullptr;
+        }
+    }
+
+    if (!audioStream) {
+        LOG_ERROR(Log::Category::Audio, "Failed to open granular audio stream: {}", SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+void GranularVoice::SetOutputDevice(SDL_AudioDeviceID outputDevice) {
+    if (!audioStream || ownsDevice) {
+        return;
+    }
+
+    SDL_UnbindAudioStream(audioStream);
+    if (!SDL_BindAudioStream(outputDevice, audioStream)) {
+        LOG_ERROR(Log::Category::Audio, "Failed to rebind granular stream: {}", SDL_GetError());
+    }
+}
+
+void GranularVoice::SetSampleRate(int newSampleRate) {
+    if (newSampleRate <= 0 || newSampleRate == sampleRate) {
+        return;
+    }
+
+    if (audioStream) SDL_LockAudioStream(audioStream);
+
+    // Rescale per-sample increments so live grains keep their pitch and length
+    float ratio = static_cast<float>(sampleRate) / static_cast<float>(newSampleRate);
+    for (int g = 0; g < activeGrains; g++) {
+        grainIncrement[g] *= ratio;
+        grainPhaseInc[g] *= ratio;
+    }
+    samplesUntilNextGrain /= ratio;
+    sampleRate = newSampleRate;
+
+    if (audioStream) {
+        streamSpec.freq = sampleRate;
+        SDL_SetAudioStreamFormat(audioStream, &streamSpec, nullptr);
+        SDL_UnlockAudioStream(audioStream);
+    }
+}
+
+void GranularVoice::SetSource(const std::vector<float>& source, int sourceRate) {
+    if (audioStream) SDL_LockAudioStream(audioStream);
+    sourceData = source;
+    sourceSampleRate = sourceRate;
+    activeGrains = 0;
+    if (audioStream) SDL_UnlockAudioStream(audioStream);
+}
+
+void GranularVoice::SetParams(const GranularParams& newParams) {
+    if (audioStream) SDL_LockAudioStream(audioStream);
+    params = newParams;
+    if (audioStream) SDL_UnlockAudioStream(audioStream);
+}
+
+GranularParams GranularVoice::GetParams() const {
+    return params;
+}
+
+void GranularVoice::Play() {
+    if (audioStream) {
+        SDL_LockAudioStream(audioStream);
+        active = true;
+        SDL_UnlockAudioStream(audioStream);
+        if (ownsDevice) {
+            SDL_ResumeAudioStreamDevice(audioStream);
+        }
+    }
+}
+
+void GranularVoice::Stop() {
+    if (audioStream) {
+        if (ownsDevice) {
+            SDL_PauseAudioStreamDevice(audioStream);
+        }
+        SDL_LockAudioStream(audioStream);
+        active = false;
+        activeGrains = 0;
+        samplesUntilNextGrain = 0.0f;
+        SDL_ClearAudioStream(audioStream);
+        SDL_UnlockAudioStream(audioStream);
+    }
+}
+
+int GranularVoice::GetSampleRate() const {
+    return sampleRate;
+}
+
+int GranularVoice::GetActiveGrainCount() const {
+    return activeGrains;
+}
+
+float GranularVoice::NextRandom() {
+    // xorshift32 - cheap and good enough for jitter
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return static_cast<float>(randomState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+void GranularVoice::SpawnGrain(int offset) {
+    if (activeGrains >= MAX_GRAINS || sourceData.size() < 2) {
+        return; // Pool exhausted, drop the grain
+    }
+
+    int g = activeGrains++;
+    float sourceLength = static_cast<float>(sourceData.size() - 1);
+    float grainSamples = std::max(1.0f, params.grainDurationMs * 0.001f * sampleRate);
+
+    float position = params.position + params.positionJitter * NextRandom();
+    position = std::clamp(position, 0.0f, 1.0f) * sourceLength;
+    float rateRatio = static_cast<float>(sourceSampleRate) / static_cast<float>(sampleRate);
+    float increment = std::max(0.0f, params.pitch * rateRatio * (1.0f + params.pitchJitter * NextRandom()));
+
+    // Grains that start later in the block begin with a negative phase
+    grainPhaseInc[g] = 1.0f / grainSamples;
+    grainPhase[g] = -static_cast<float>(offset) * grainPhaseInc[g];
+    grainIncrement[g] = increment;
+    grainPosition[g] = position - static_cast<float>(offset) * increment;
+
+    // Equal-power pan, scaled down by the expected number of overlapping grains
+    float pan = std::clamp(params.panJitter * NextRandom(), -1.0f, 1.0f);
+    float angle = (pan + 1.0f) * static_cast<float>(M_PI / 4.0);
+    float overlap = std::max(1.0f, params.grainsPerSecond * params.grainDurationMs * 0.001f);
+    float gain = params.amplitude / std::sqrt(overlap);
+    grainGainLeft[g] = std::cos(angle) * gain;
+    grainGainRight[g] = std::sin(angle) * gain;
+}
+
+void GranularVoice::RenderGrain(int g, float* outLeft, float* outRight, int frames) {
+    const float* src = sourceData.data();
+    const float maxIndex = static_cast<float>(sourceData.size() - 2);
+    const float increment = grainIncrement[g];
+    const float phaseInc = grainPhaseInc[g];
+    const float gainLeft = grainGainLeft[g];
+    const float gainRight = grainGainRight[g];
+
+    float position = grainPosition[g];
+    float phase = grainPhase[g];
+    int i = 0;
+
+#if defined(__AVX2__)
+    const __m256 ramp = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 four = _mm256_set1_ps(4.0f);
+    const __m256 five = _mm256_set1_ps(5.0f);
+    const __m256 upper = _mm256_set1_ps(maxIndex);
+    const __m256 posStep = _mm256_set1_ps(increment * 8.0f);
+    const __m256 phaseStep = _mm256_set1_ps(phaseInc * 8.0f);
+    const __m256 vGainLeft = _mm256_set1_ps(gainLeft);
+    const __m256 vGainRight = _mm256_set1_ps(gainRight);
+
+    __m256 vPos = _mm256_add_ps(_mm256_set1_ps(position), _mm256_mul_ps(ramp, _mm256_set1_ps(increment)));
+    __m256 vPhase = _mm256_add_ps(_mm256_set1_ps(phase), _mm256_mul_ps(ramp, _mm256_set1_ps(phaseInc)));
+
+    for (; i + 8 <= frames; i += 8) {
+        // Lanes outside [0, 1) are either not started yet or already finished
+        __m256 live = _mm256_and_ps(_mm256_cmp_ps(vPhase, zero, _CMP_GE_OQ), _mm256_cmp_ps(vPhase, one, _CMP_LT_OQ));
+        if (_mm256_movemask_ps(live) != 0) {
+            __m256 x = _mm256_mul_ps(_mm256_mul_ps(four, vPhase), _mm256_sub_ps(one, vPhase));
+            __m256 s = _mm256_div_ps(_mm256_mul_ps(four, x), _mm256_sub_ps(five, x));
+            __m256 window = _mm256_and_ps(_mm256_mul_ps(s, s), live);
+
+            // Linear interpolation between neighbouring source samples
+            __m256 clamped = _mm256_min_ps(_mm256_max_ps(vPos, zero), upper);
+            __m256i index = _mm256_cvttps_epi32(clamped);
+            __m256 frac = _mm256_sub_ps(clamped, _mm256_cvtepi32_ps(index));
+            __m256 a = _mm256_i32gather_ps(src, index, 4);
+            __m256 b = _mm256_i32gather_ps(src + 1, index, 4);
+            __m256 sample = _mm256_mul_ps(_mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), frac)), window);
+
+            _mm256_storeu_ps(outLeft + i, _mm256_add_ps(_mm256_loadu_ps(outLeft + i), _mm256_mul_ps(sample, vGainLeft)));
+            _mm256_storeu_ps(outRight + i, _mm256_add_ps(_mm256_loadu_ps(outRight + i), _mm256_mul_ps(sample, vGainRight)));
+        }
+        else if (_mm256_cvtss_f32(vPhase) >= 1.0f) {
+            return; // Grain finished, nothing left in this block
+        }
+
+        vPos = _mm256_add_ps(vPos, posStep);
+        vPhase = _mm256_add_ps(vPhase, phaseStep);
+    }
+
+    position += increment * static_cast<float>(i);
+    phase += phaseInc * static_cast<float>(i);
+#endif
+
+    // Scalar tail (or the whole block without AVX2)
+    for (; i < frames; i++) {
+        float window = GrainWindow(phase);
+        if (window > 0.0f) {
+            float clamped = std::clamp(position, 0.0f, maxIndex);
+            int index = static_cast<int>(clamped);
+            float frac = clamped - static_cast<float>(index);
+            float sample = (src[index] + (src[index + 1] - src[index]) * frac) * window;
+            outLeft[i] += sample * gainLeft;
+            outRight[i] += sample * gainRight;
+        }
+        position += increment;
+        phase += phaseInc;
+    }
+}
+
+void GranularVoice::Render(float* outLeft, float* outRight, int frames) {
+    if (sourceData.size() < 2) {
+        return;
+    }
+
+    // Schedule every grain that starts inside this block
+    float interval = static_cast<float>(sampleRate) / std::max(params.grainsPerSecond, 1.0f);
+    while (samplesUntilNextGrain < static_cast<float>(frames)) {
+        SpawnGrain(static_cast<int>(samplesUntilNextGrain));
+        samplesUntilNextGrain += interval;
+    }
+    samplesUntilNextGrain -= static_cast<float>(frames);
+
+    for (int g = 0; g < activeGrains; ) {
+        RenderGrain(g, outLeft, outRight, frames);
+
+        grainPosition[g] += grainIncrement[g] * frames;
+        grainPhase[g] += grainPhaseInc[g] * frames;
+
+        if (grainPhase[g] >= 1.0f) {
+            // Swap-remove the finished grain to keep the pool dense
+            int last = --activeGrains;
+            grainPosition[g] = grainPosition[last];
+            grainIncrement[g] = grainIncrement[last];
+            grainPhase[g] = grainPhase[last];
+            grainPhaseInc[g] = grainPhaseInc[last];
+            grainGainLeft[g] = grainGainLeft[last];
+            grainGainRight[g] = grainGainRight[last];
+        } else {
+            g++;
+        }
+    }
+}
+
+void SDLCALL GranularVoice::StreamCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount) {
+    GranularVoice* voice = static_cast<GranularVoice*>(userdata);
+    (void)totalAmount;
+    if (!voice->active) {
+        return; // SDL plays silence for an empty stream
+    }
+    int framesNeeded = additionalAmount / static_cast<int>(2 * sizeof(float));
+
+    while (framesNeeded > 0) {
+        int frames = std::min(framesNeeded, RENDER_BLOCK_FRAMES);
+
+        std::fill(voice->mixLeft.begin(), voice->mixLeft.begin() + frames, 0.0f);
+        std::fill(voice->mixRight.begin(), voice->mixRight.begin() + frames, 0.0f);
+        voice->Render(voice->mixLeft.data(), voice->mixRight.data(), frames);
+
+        for (int i = 0; i < frames; i++) {
+            voice->interleaved[i * 2] = voice->mixLeft[i];
+            voice->interleaved[i * 2 + 1] = voice->mixRight[i];
+        }
+        SDL_PutAudioStreamData(stream, voice->interleaved.data(), frames * 2 * static_cast<int>(sizeof(float)));
+
+        framesNeeded -= frames;
+    }
+}
@@ -1,26 +1,213 @@
 #include <audio/mixer.hpp>
 #include <audio/audio.hpp>
-#include <iostream>
+#include <threading/threading.hpp>
+#include <profiling/latency_tracer.hpp>
+#include <memory/memory_tracker.hpp>
+#include <logging/logger.hpp>
 #include <SDL3/SDL.h>
 #include <cmath>
 
 // Global mixer instance
 AudioMixer* gAudioMixer = nullptr;
 
-AudioMixer::AudioMixer() : nextChannelId(1), longSustainMode(false), fadeOutDuration(15) {
-    // Default fade-out duration is 15ms
+namespace {
+    bool SameComponents(const std::vector<WaveComponent>& a, const std::vector<WaveComponent>& b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i].type != b[i].type || a[i].frequency != b[i].frequency || a[i].amplitude != b[i].amplitude) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+AudioMixer::AudioMixer() : nextChannelId(1), longSustainMode(false), fadeOutDuration(15),
+                           outputDevice(0), deviceSampleRate(48000), deviceBufferFrames(0),
+                           waveCacheBytes(0), waveCacheLimit(16 * 1024 * 1024) {
+    // Default fade-out duration is 15ms, default wave cache limit is 16MB
 }
 
 AudioMixer::~AudioMixer() {
     StopAllSounds();
+    
+    if (outputDevice != 0) {
+        SDL_CloseAudioDevice(outputDevice);
+    }
 }
 
 bool AudioMixer::Initialize() {
-    std::cout << "Audio mixer initialized" << std::endl;
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
+    if (!SDL_Init(SDL_INIT_AUDIO)) {
+        LOG_ERROR(Log::Category::Audio, "Failed to initialize SDL audio: {}", SDL_GetError());
+        return false;
+    }
+    
+    // Without a shared device every channel falls back to opening its own
+    if (!OpenOutputDevice()) {
+        LOG_WARNING(Log::Category::Audio, "Audio mixer running without a shared output device");
+    }
+    
+    LOG_INFO(Log::Category::Audio, "Audio mixer initialized ({} Hz, {} frame blocks)", deviceSampleRate, deviceBufferFrames);
     return true;
 }
 
+bool AudioMixer::OpenOutputDevice() {
+    // Opening the default device lets SDL follow default-device changes for us
+    outputDevice = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, nullptr);
+    if (outputDevice == 0) {
+        LOG_ERROR(Log::Category::Audio, "Failed to open audio device: {}", SDL_GetError());
+        return false;
+    }
+    
+    SDL_AudioSpec spec;
+    int sampleFrames = 0;
+    if (SDL_GetAudioDeviceFormat(outputDevice, &spec, &sampleFrames)) {
+        deviceSampleRate = spec.freq;
+        deviceBufferFrames = sampleFrames;
+    }
+    
+    // Configure SDL's device thread from the first mix it runs
+    SDL_SetAudioPostmixCallback(outputDevice, PostmixCallback, this);
+    
+    SDL_ResumeAudioDevice(outputDevice);
+    return true;
+}
+
+void SDLCALL AudioMixer::PostmixCallback(void* userdata, const SDL_AudioSpec* spec, float* buffer, int buflen) {
+    (void)userdata;
+    (void)spec;
+    (void)buffer;
+    (void)buflen;
+    
+    // SDL owns this thread, so the audio role is applied once from inside it
+    static thread_local bool threadConfigured = false;
+    if (!threadConfigured) {
+        threadConfigured = true;
+        Threading::applyToCurrentThread(Threading::configForRole(Threading::ThreadRole::Audio, "audio"));
+    }
+}
+
+void AudioMixer::ReprepareChannels(int newSampleRate) {
+    // Voices keep their buffers and streams; only the stream formats and
+    // rate-dependent state change here, nothing is rendered under channelsMutex
+    for (auto& pair : audioChannels) {
+        if (pair.second->audioSystem) {
+            pair.second->audioSystem->SetSampleRate(newSampleRate);
+        }
+        if (pair.second->granularVoice) {
+            pair.second->granularVoice->SetSampleRate(newSampleRate);
+        }
+    }
+    deviceSampleRate = newSampleRate;
+}
+
+void AudioMixer::HandleDeviceEvent(const SDL_Event& event) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
+    if (event.type != SDL_EVENT_AUDIO_DEVICE_ADDED &&
+        event.type != SDL_EVENT_AUDIO_DEVICE_REMOVED &&
+        event.type != SDL_EVENT_AUDIO_DEVICE_FORMAT_CHANGED) {
+        return;
+    }
+    if (event.adevice.recording) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(channelsMutex);
+    uint64_t switchStart = SDL_GetTicksNS();
+    
+    bool deviceLost = (event.type == SDL_EVENT_AUDIO_DEVICE_REMOVED && event.adevice.which == outputDevice);
+    bool deviceMissing = (outputDevice == 0 && event.type == SDL_EVENT_AUDIO_DEVICE_ADDED);
+    
+    if (deviceLost || deviceMissing) {
+        // Closing the lost device unbinds every stream but keeps their queued audio
+        if (outputDevice != 0) {
+            SDL_CloseAudioDevice(outputDevice);
+            outputDevice = 0;
+        }
+        
+        int previousRate = deviceSampleRate;
+        if (!OpenOutputDevice()) {
+            return; // Try again on the next device event
+        }
+        
+        for (auto& pair : audioChannels) {
+            if (pair.second->audioSystem) {
+                pair.second->audioSystem->SetOutputDevice(outputDevice);
+            }
+            if (pair.second->granularVoice) {
+                pair.second->granularVoice->SetOutputDevice(outputDevice);
+            }
+        }
+        
+        if (deviceSampleRate != previousRate) {
+            ReprepareChannels(deviceSampleRate);
+        }
+    } else if (outputDevice != 0) {
+        // The default device may have been swapped underneath us with a different rate
+        SDL_AudioSpec spec;
+        int sampleFrames = 0;
+        if (!SDL_GetAudioDeviceFormat(outputDevice, &spec, &sampleFrames) || spec.freq == deviceSampleRate) {
+            return;
+        }
+        deviceBufferFrames = sampleFrames;
+        ReprepareChannels(spec.freq);
+    } else {
+        return;
+    }
+    
+    double switchMs = static_cast<double>(SDL_GetTicksNS() - switchStart) / 1000000.0;
+    double blockMs = deviceSampleRate > 0 ? 1000.0 * deviceBufferFrames / deviceSampleRate : 0.0;
+    LOG_INFO(Log::Category::Audio, "Audio output switched to {} Hz in {}ms (device block {}ms)",
+             deviceSampleRate, switchMs, blockMs);
+}
+
+int AudioMixer::GetSampleRate() const {
+    return deviceSampleRate;
+}
+
+SDL_AudioDeviceID AudioMixer::GetOutputDevice() const {
+    return outputDevice;
+}
+
+int AudioMixer::GetActiveChannelCount(int sampleRate) {
+    std::lock_guard<std::mutex> lock(channelsMutex);
+    int count = 0;
+    for (const auto& pair : audioChannels) {
+        const ActiveChannel* channel = pair.second.get();
+        if (!channel->isActive) {
+            continue;
+        }
+        int channelRate = channel->audioSystem ? channel->audioSystem->GetSampleRate()
+                        : channel->granularVoice ? channel->granularVoice->GetSampleRate() : 0;
+        if (sampleRate == 0 || channelRate == sampleRate) {
+            count++;
+        }
+    }
+    return count;
+}
+
 int AudioMixer::PlaySound(float frequency, int durationMs) {
+    return StartToneChannel(frequency, durationMs, -1);
+}
+
+int AudioMixer::PlayNote(NoteId note, float frequency, int durationMs) {
+    return StartToneChannel(frequency, durationMs, note);
+}
+
+void AudioMixer::StopNote(NoteId note) {
+    std::lock_guard<std::mutex> lock(channelsMutex);
+    for (auto& pair : audioChannels) {
+        if (pair.second->note == note) {
+            StartFadeOut(pair.second.get());
+        }
+    }
+}
+
+int AudioMixer::StartToneChannel(float frequency, int durationMs, int note) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     std::lock_guard<std::mutex> lock(channelsMutex);
     
     int actualDuration = longSustainMode ? 5000 : durationMs; // Use longer duration if sustain mode is on
@@ -28,26 +215,32 @@ int AudioMixer::PlaySound(float frequency, int durationMs) {
     // Create a new audio system for this sound
     int channelId = nextChannelId++;
     auto channel = std::make_unique<ActiveChannel>();
-    channel->audioSystem = std::make_unique<AudioSystem>();
+    channel->audioSystem = std::make_unique<AudioSystem>(deviceSampleRate);
     channel->isActive = true;
     channel->isFadingOut = false;
     channel->startTime = SDL_GetTicks();
     channel->fadeDuration = fadeOutDuration;
     channel->totalDuration = actualDuration;
+    channel->note = note;
     
-    if (!channel->audioSystem->Initialize()) {
-        std::cerr << "Failed to initialize audio system for channel " << channelId << std::endl;
+    if (!channel->audioSystem->Initialize(outputDevice)) {
+        LOG_ERROR(Log::Category::Audio, "Failed to initialize audio system for channel {}", channelId);
         return -1;
     }
     
     // Configure and play the sound
     channel->audioSystem->SetFrequency(frequency);
     
+    // Notes started from a key event carry its latency trace to the device
+    uint32_t latencyTrace = LatencyTracer::currentSoundTrace();
+    channel->audioSystem->SetLatencyTrace(latencyTrace);
+    
     // Start playback
     channel->audioSystem->PlaySound();
+    gLatencyTracer.onSoundStage(latencyTrace, LatencyStage::NoteOn);
     
     // Start a new thread to manage the sound's lifecycle
-    std::thread([this, channelId, actualDuration]() {
+    Threading::createThread(Threading::configForRole(Threading::ThreadRole::Worker, "note lifecycle"), [this, channelId, actualDuration]() {
         // Wait until just before the end of the sound duration
         int timeToSleep = actualDuration - static_cast<int>(this->fadeOutDuration) - 5; // 5ms safety margin
         if (timeToSleep > 0) {
@@ -104,30 +297,45 @@ void AudioMixer::StopAllSounds() {
     
     // Now stop all sounds and clear the channels
     for (auto& pair : audioChannels) {
-        pair.second->audioSystem->StopSound();
+        StopChannelOutput(pair.second.get());
     }
     audioChannels.clear();
 }
 
 void AudioMixer::AddSample(const std::string& name, WaveType type, float freq, float amplitude) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     WaveComponent component{type, freq, amplitude};
     
-    // If sample doesn't exist, create it
-    if (samples.find(name) == samples.end()) {
-        samples[name] = std::vector<WaveComponent>();
+    // Nothing is rendered until the component list is complete; a stale
+    // rendering of the shorter list ages out of the cache like any other
+    samples[name].push_back(component);
+    LOG_INFO(Log::Category::Audio, "Added {} wave component to sample '{}'", static_cast<int>(type), name);
+}
+
+void AudioMixer::PrepareSample(const std::string& name) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
+    auto it = samples.find(name);
+    if (it == samples.end()) {
+        LOG_ERROR(Log::Category::Audio, "Sample '{}' not found", name);
+        return;
     }
     
-    samples[name].push_back(component);
-    std::cout << "Added " << static_cast<int>(type) << " wave component to sample '" << name << "'" << std::endl;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    GetCachedWave(it->second);
 }
 
 void AudioMixer::PlaySample(const std::string& name, int durationMs) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     auto it = samples.find(name);
     if (it == samples.end()) {
-        std::cerr << "Sample '" << name << "' not found" << std::endl;
+        LOG_ERROR(Log::Category::Audio, "Sample '{}' not found", name);
         return;
     }
     
+    // Look up (or render) the sample's waveform before taking the channel lock
+    std::unique_lock<std::mutex> cacheLock(cacheMutex);
+    const std::vector<float>& waveData = GetCachedWave(it->second);
+    
     std::lock_guard<std::mutex> lock(channelsMutex);
     
     int actualDuration = longSustainMode ? 5000 : durationMs;
@@ -135,34 +343,25 @@ void AudioMixer::PlaySample(const std::string& name, int durationMs) {
     // Create a new audio system for this sample
     int channelId = nextChannelId++;
     auto channel = std::make_unique<ActiveChannel>();
-    channel->audioSystem = std::make_unique<AudioSystem>();
+    channel->audioSystem = std::make_unique<AudioSystem>(deviceSampleRate);
     channel->isActive = true;
     channel->isFadingOut = false;
     channel->startTime = SDL_GetTicks();
     channel->fadeDuration = fadeOutDuration;
     channel->totalDuration = actualDuration;
+    channel->note = -1;
     
-    if (!channel->audioSystem->Initialize()) {
-        std::cerr << "Failed to initialize audio system for sample '" << name << "'" << std::endl;
+    if (!channel->audioSystem->Initialize(outputDevice)) {
+        LOG_ERROR(Log::Category::Audio, "Failed to initialize audio system for sample '{}'", name);
         return;
     }
     
-    // Clear default wave components
-    channel->audioSystem->ClearWaveComponents();
-    
-    // Add all wave components from the sample
-    for (const auto& component : it->second) {
-        channel->audioSystem->AddWaveComponent(component.type, component.frequency, component.amplitude);
-    }
-    
-    // Generate the complex wave
-    channel->audioSystem->GenerateComplexWave();
-    
-    // Start playback
-    channel->audioSystem->PlaySound();
+    // Start playback straight from the cached waveform
+    channel->audioSystem->PlaySound(waveData);
+    cacheLock.unlock();
     
     // Start a new thread to manage the sound's lifecycle
-    std::thread([this, channelId, name, actualDuration]() {
+    Threading::createThread(Threading::configForRole(Threading::ThreadRole::Worker, "note lifecycle"), [this, channelId, name, actualDuration]() {
         // Wait until just before the end of the sound duration
         int timeToSleep = actualDuration - static_cast<int>(this->fadeOutDuration) - 50; // 5ms safety margin
         if (timeToSleep > 0) {
@@ -187,23 +386,193 @@ void AudioMixer::PlaySample(const std::string& name, int durationMs) {
         if (it != this->audioChannels.end()) {
             it->second->audioSystem->StopSound();
             this->audioChannels.erase(it);
-            std::cout << "Sample '" << name << "' playback finished" << std::endl;
+            LOG_INFO(Log::Category::Audio, "Sample '{}' playback finished", name);
         }
     }).detach();
     
     // Store the channel (move ownership to the map)
     audioChannels[channelId] = std::move(channel);
-    std::cout << "Playing sample '" << name << "' for " << actualDuration << "ms" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Playing sample '{}' for {}ms", name, actualDuration);
+}
+
+int AudioMixer::PlayGranular(const std::string& name, const GranularParams& params, int durationMs) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
+    auto it = samples.find(name);
+    if (it == samples.end()) {
+        LOG_ERROR(Log::Category::Audio, "Sample '{}' not found", name);
+        return -1;
+    }
+    
+    // The cached rendering of the sample is the grain source
+    std::unique_lock<std::mutex> cacheLock(cacheMutex);
+    const std::vector<float>& sourceData = GetCachedWave(it->second);
+    
+    std::lock_guard<std::mutex> lock(channelsMutex);
+    
+    int actualDuration = longSustainMode ? 5000 : durationMs;
+    
+    // Create a new granular voice for this sample
+    int channelId = nextChannelId++;
+    auto channel = std::make_unique<ActiveChannel>();
+    channel->granularVoice = std::make_unique<GranularVoice>();
+    channel->isActive = true;
+    channel->isFadingOut = false;
+    channel->startTime = SDL_GetTicks();
+    channel->fadeDuration = fadeOutDuration;
+    channel->totalDuration = actualDuration;
+    channel->note = -1;
+    
+    if (!channel->granularVoice->Initialize(outputDevice, deviceSampleRate)) {
+        LOG_ERROR(Log::Category::Audio, "Failed to initialize granular voice for sample '{}'", name);
+        return -1;
+    }
+    
+    channel->granularVoice->SetSource(sourceData, deviceSampleRate);
+    cacheLock.unlock();
+    channel->granularVoice->SetParams(params);
+    channel->granularVoice->Play();
+    
+    // Start a new thread to manage the voice's lifecycle
+    Threading::createThread(Threading::configForRole(Threading::ThreadRole::Worker, "note lifecycle"), [this, channelId, actualDuration]() {
+        // Wait until just before the end of the sound duration
+        int timeToSleep = actualDuration - static_cast<int>(this->fadeOutDuration) - 5; // 5ms safety margin
+        if (timeToSleep > 0) {
+            SDL_Delay(timeToSleep);
+        }
+        
+        // Initiate fade-out
+        {
+            std::lock_guard<std::mutex> fadelock(this->channelsMutex);
+            auto it = this->audioChannels.find(channelId);
+            if (it != this->audioChannels.end() && it->second->isActive) {
+                this->StartFadeOut(it->second.get());
+            }
+        }
+        
+        // Wait for fade-out to complete
+        SDL_Delay(this->fadeOutDuration + 10);
+        
+        // Clean up after the voice finishes
+        std::lock_guard<std::mutex> cleanupLock(this->channelsMutex);
+        auto it = this->audioChannels.find(channelId);
+        if (it != this->audioChannels.end()) {
+            this->StopChannelOutput(it->second.get());
+            this->audioChannels.erase(it);
+        }
+    }).detach();
+    
+    // Store the channel (move ownership to the map)
+    audioChannels[channelId] = std::move(channel);
+    LOG_INFO(Log::Category::Audio, "Playing granular sample '{}' for {}ms", name, actualDuration);
+    
+    return channelId;
 }
 
 void AudioMixer::ClearSamples() {
     samples.clear();
-    std::cout << "All samples cleared" << std::endl;
+    
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    waveCache.clear();
+    waveCacheLru.clear();
+    waveCacheBytes = 0;
+    LOG_INFO(Log::Category::Audio, "All samples cleared");
+}
+
+bool AudioMixer::HasSample(const std::string& name) const {
+    return samples.find(name) != samples.end();
+}
+
+void AudioMixer::SetWaveCacheLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    waveCacheLimit = bytes;
+    
+    // Drop least recently used waveforms until we fit again
+    while (waveCacheBytes > waveCacheLimit && !waveCacheLru.empty()) {
+        EvictCachedWave(waveCacheLru.back());
+    }
+}
+
+size_t AudioMixer::GetWaveCacheBytes() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return waveCacheBytes;
+}
+
+uint64_t AudioMixer::HashComponents(const std::vector<WaveComponent>& components) const {
+    // FNV-1a over the component fields and the output rate
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    
+    mix(static_cast<uint32_t>(deviceSampleRate));
+    for (const auto& component : components) {
+        uint32_t frequencyBits, amplitudeBits;
+        SDL_memcpy(&frequencyBits, &component.frequency, sizeof(frequencyBits));
+        SDL_memcpy(&amplitudeBits, &component.amplitude, sizeof(amplitudeBits));
+        mix(static_cast<uint32_t>(component.type));
+        mix(frequencyBits);
+        mix(amplitudeBits);
+    }
+    return hash;
+}
+
+const std::vector<float>& AudioMixer::GetCachedWave(const std::vector<WaveComponent>& components) {
+    // Caller holds cacheMutex
+    uint64_t key = HashComponents(components);
+    
+    auto it = waveCache.find(key);
+    if (it != waveCache.end()) {
+        if (it->second.sampleRate == deviceSampleRate && SameComponents(it->second.components, components)) {
+            // Mark as most recently used
+            waveCacheLru.splice(waveCacheLru.begin(), waveCacheLru, it->second.lruPosition);
+            return it->second.pcm;
+        }
+        // Hash collision: the other list loses its slot and is rendered again when next used
+        EvictCachedWave(key);
+    }
+    
+    // Render once with band-limited oscillators
+    AudioSystem renderer(deviceSampleRate);
+    renderer.ClearWaveComponents();
+    for (const auto& component : components) {
+        renderer.AddWaveComponent(component.type, component.frequency, component.amplitude);
+    }
+    renderer.GenerateBandLimitedWave();
+    
+    CachedWave& entry = waveCache[key];
+    entry.components = components;
+    entry.sampleRate = deviceSampleRate;
+    entry.pcm = renderer.GetWaveData();
+    waveCacheLru.push_front(key);
+    entry.lruPosition = waveCacheLru.begin();
+    waveCacheBytes += entry.pcm.size() * sizeof(float);
+    
+    // Evict least recently used entries, but never the one we just rendered
+    while (waveCacheBytes > waveCacheLimit && waveCacheLru.size() > 1) {
+        EvictCachedWave(waveCacheLru.back());
+    }
+    
+    return entry.pcm;
+}
+
+void AudioMixer::EvictCachedWave(uint64_t key) {
+    // Caller holds cacheMutex
+    auto it = waveCache.find(key);
+    if (it == waveCache.end()) {
+        return;
+    }
+    
+    waveCacheBytes -= it->second.pcm.size() * sizeof(float);
+    waveCacheLru.erase(it->second.lruPosition);
+    waveCache.erase(it);
 }
 
 void AudioMixer::ToggleSustainMode() {
     longSustainMode = !longSustainMode;
-    std::cout << "Sustain mode: " << (longSustainMode ? "ON" : "OFF") << std::endl;
+    LOG_INFO(Log::Category::Audio, "Sustain mode: {}", longSustainMode ? "ON" : "OFF");
 }
 
 bool AudioMixer::IsSustainModeEnabled() const {
@@ -212,7 +581,7 @@ bool AudioMixer::IsSustainModeEnabled() const {
 
 void AudioMixer::SetFadeOutDuration(uint64_t durationMs) {
     fadeOutDuration = durationMs;
-    std::cout << "Fade-out duration set to " << fadeOutDuration << "ms" << std::endl;
+    LOG_INFO(Log::Category::Audio, "Fade-out duration set to {}ms", fadeOutDuration);
 }
 
 uint64_t AudioMixer::GetFadeOutDuration() const {
@@ -227,6 +596,15 @@ void AudioMixer::StartFadeOut(ActiveChannel* channel) {
     }
 }
 
+void AudioMixer::StopChannelOutput(ActiveChannel* channel) {
+    if (channel->audioSystem) {
+        channel->audioSystem->StopSound();
+    }
+    if (channel->granularVoice) {
+        channel->granularVoice->Stop();
+    }
+}
+
 float AudioMixer::CalculateFadeOutVolume(uint64_t currentTime, uint64_t startFadeTime, uint64_t fadeDuration) {
     // Calculate elapsed time since fade started
     uint64_t elapsed = currentTime - startFadeTime;
@@ -245,6 +623,7 @@ float AudioMixer::CalculateFadeOutVolume(uint64_t currentTime, uint64_t startFad
 }
 
 void AudioMixer::Update() {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     std::lock_guard<std::mutex> lock(channelsMutex);
     uint64_t currentTime = SDL_GetTicks();
     
@@ -265,7 +644,7 @@ void AudioMixer::Update() {
             // For now, we'll just stop the sound once fade reaches near zero
             if (volume <= 0.001f) {
                 // Fade complete, stop the sound
-                it->second->audioSystem->StopSound();
+                StopChannelOutput(it->second.get());
                 it = audioChannels.erase(it);
                 continue;
             }
@@ -278,6 +657,7 @@ void AudioMixer::Update() {
 
 // Global helper functions
 void InitializeAudioMixer() {
+    MEMORY_TAG_SCOPE(Memory::Tag::Audio);
     if (!gAudioMixer) {
         gAudioMixer = new AudioMixer();
         gAudioMixer->Initialize();
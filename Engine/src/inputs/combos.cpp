@@ -0,0 +1,301 @@
+#include <inputs/combos.hpp>
+#include <memory/memory_tracker.hpp>
+#include <logging/logger.hpp>
+#include <algorithm>
+#include <fstream>
+#include <queue>
+#include <sstream>
+
+namespace Keyboard {
+
+ComboMatcher Combos;
+
+namespace {
+    constexpr uint32_t NO_STATE = 0xFFFFFFFF;
+}
+
+ComboId ComboMatcher::addCombo(const ComboDefinition& definition) {
+    if (combos.size() >= INVALID_COMBO || definition.steps.empty()) {
+        LOG_ERROR(Log::Category::Input, "Cannot add combo: {}", definition.name);
+        return INVALID_COMBO;
+    }
+
+    ComboId id = static_cast<ComboId>(combos.size());
+    combos.push_back(definition);
+    comboCallbacks.emplace_back();
+    comboIds[definition.name] = id;
+    compiled = false;
+    return id;
+}
+
+void ComboMatcher::clear() {
+    combos.clear();
+    comboCallbacks.clear();
+    comboIds.clear();
+    compile();
+}
+
+void ComboMatcher::compile() {
+    // Dense symbols for the actions that appear in any combo
+    actionSymbols.clear();
+    symbolCount = 0;
+    for (const ComboDefinition& combo : combos) {
+        for (const auto& step : combo.steps) {
+            for (ActionId action : step) {
+                if (action >= actionSymbols.size()) {
+                    actionSymbols.resize(action + 1, -1);
+                }
+                if (actionSymbols[action] < 0) {
+                    actionSymbols[action] = static_cast<int32_t>(symbolCount++);
+                }
+            }
+        }
+    }
+
+    // Trie of every press order; the root is state 0
+    transitions.assign(symbolCount, NO_STATE);
+    std::vector<std::vector<uint32_t>> stateOutputs(1);
+    patterns.clear();
+    patternLimits.clear();
+
+    for (size_t comboIndex = 0; comboIndex < combos.size(); comboIndex++) {
+        const ComboDefinition& combo = combos[comboIndex];
+
+        // Expand the chords into every press order, step by step; expansion
+        // stops as soon as there are too many orders to match them all
+        std::vector<std::vector<ActionId>> sequences(1);
+        std::vector<std::vector<uint64_t>> limits(1);
+        for (const auto& step : combo.steps) {
+            if (sequences.size() > MAX_PATTERNS_PER_COMBO) {
+                break;
+            }
+            std::vector<ActionId> order(step);
+            std::sort(order.begin(), order.end());
+
+            std::vector<std::vector<ActionId>> nextSequences;
+            std::vector<std::vector<uint64_t>> nextLimits;
+            do {
+                for (size_t i = 0; i < sequences.size(); i++) {
+                    std::vector<ActionId> sequence = sequences[i];
+                    std::vector<uint64_t> limit = limits[i];
+                    for (size_t press = 0; press < order.size(); press++) {
+                        if (!sequence.empty()) {
+                            uint32_t windowMs = press == 0 ? combo.stepWindowMs : combo.chordWindowMs;
+                            limit.push_back(SDL_MS_TO_NS(static_cast<uint64_t>(windowMs)));
+                        }
+                        sequence.push_back(order[press]);
+                    }
+                    nextSequences.push_back(std::move(sequence));
+                    nextLimits.push_back(std::move(limit));
+                }
+            } while (std::next_permutation(order.begin(), order.end()) &&
+                     nextSequences.size() <= MAX_PATTERNS_PER_COMBO);
+
+            sequences = std::move(nextSequences);
+            limits = std::move(nextLimits);
+        }
+        if (sequences.size() > MAX_PATTERNS_PER_COMBO) {
+            LOG_WARNING(Log::Category::Input, "Combo {} has more than {} press orders, ignored",
+                        combo.name, MAX_PATTERNS_PER_COMBO);
+            continue;
+        }
+
+        for (size_t i = 0; i < sequences.size(); i++) {
+            const std::vector<ActionId>& sequence = sequences[i];
+            if (sequence.size() > HISTORY_SIZE) {
+                LOG_WARNING(Log::Category::Input, "Combo {} is longer than {} presses, ignored", combo.name, HISTORY_SIZE);
+                break;
+            }
+
+            uint32_t current = 0;
+            for (ActionId action : sequence) {
+                size_t slot = current * symbolCount + actionSymbols[action];
+                if (transitions[slot] == NO_STATE) {
+                    transitions[slot] = static_cast<uint32_t>(stateOutputs.size());
+                    stateOutputs.emplace_back();
+                    transitions.resize(transitions.size() + symbolCount, NO_STATE);
+                }
+                current = transitions[slot];
+            }
+
+            Pattern pattern;
+            pattern.combo = static_cast<ComboId>(comboIndex);
+            pattern.firstLimit = static_cast<uint32_t>(patternLimits.size());
+            pattern.length = static_cast<uint16_t>(sequence.size());
+            patternLimits.insert(patternLimits.end(), limits[i].begin(), limits[i].end());
+            stateOutputs[current].push_back(static_cast<uint32_t>(patterns.size()));
+            patterns.push_back(pattern);
+        }
+    }
+
+    // Fail links in breadth-first order turn the trie into a complete
+    // transition table; each state also reports the patterns of its suffixes
+    size_t stateCount = stateOutputs.size();
+    std::vector<uint32_t> fail(stateCount, 0);
+    std::queue<uint32_t> queue;
+    for (size_t symbol = 0; symbol < symbolCount; symbol++) {
+        uint32_t& next = transitions[symbol];
+        if (next == NO_STATE) {
+            next = 0;
+        } else {
+            queue.push(next);
+        }
+    }
+    while (!queue.empty()) {
+        uint32_t current = queue.front();
+        queue.pop();
+        const std::vector<uint32_t>& inherited = stateOutputs[fail[current]];
+        stateOutputs[current].insert(stateOutputs[current].end(), inherited.begin(), inherited.end());
+
+        for (size_t symbol = 0; symbol < symbolCount; symbol++) {
+            uint32_t& next = transitions[current * symbolCount + symbol];
+            uint32_t fallback = transitions[fail[current] * symbolCount + symbol];
+            if (next == NO_STATE) {
+                next = fallback;
+            } else {
+                fail[next] = fallback;
+                queue.push(next);
+            }
+        }
+    }
+
+    outputStart.assign(1, 0);
+    outputs.clear();
+    for (const auto& stateOutput : stateOutputs) {
+        outputs.insert(outputs.end(), stateOutput.begin(), stateOutput.end());
+        outputStart.push_back(static_cast<uint32_t>(outputs.size()));
+    }
+
+    state = 0;
+    historyCount = 0;
+    pending.clear();
+    triggered.clear();
+    pending.reserve(combos.size());
+    triggered.reserve(combos.size());
+    compiled = true;
+}
+
+bool ComboMatcher::loadFromFile(const std::string& filePath, KeyboardManager& input) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Input);
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        LOG_ERROR(Log::Category::Input, "Failed to open combo configuration file: {}", filePath);
+        return false;
+    }
+
+    combos.clear();
+    comboCallbacks.clear();
+    comboIds.clear();
+
+    uint32_t chordWindowMs = 50;
+    std::string line;
+    while (std::getline(file, line)) {
+        // Skip comments and empty lines
+        if (line.empty() || line[0] == '#' || line[0] == '/') {
+            continue;
+        }
+
+        std::istringstream iss(line);
+        std::string name;
+        uint32_t windowMs = 0;
+        if (!(iss >> name >> windowMs)) {
+            continue;
+        }
+        if (name == "CHORD_WINDOW") {
+            chordWindowMs = windowMs;
+            continue;
+        }
+
+        ComboDefinition combo;
+        combo.name = name;
+        combo.stepWindowMs = windowMs;
+        combo.chordWindowMs = chordWindowMs;
+
+        std::string stepText;
+        while (iss >> stepText) {
+            std::vector<ActionId> step;
+            std::istringstream chord(stepText);
+            std::string actionName;
+            while (std::getline(chord, actionName, '+')) {
+                ActionId action = input.registerAction(actionName);
+                if (action != INVALID_ACTION) {
+                    step.push_back(action);
+                }
+            }
+            if (!step.empty()) {
+                combo.steps.push_back(std::move(step));
+            }
+        }
+        addCombo(combo);
+    }
+
+    compile();
+    return true;
+}
+
+void ComboMatcher::attach(KeyboardManager& input) {
+    input.addActionPressListener([this](ActionId action, uint64_t timestampNs) {
+        onActionPressed(action, timestampNs);
+    });
+}
+
+void ComboMatcher::onActionPressed(ActionId action, uint64_t timestampNs) {
+    if (!compiled || action >= actionSymbols.size() || actionSymbols[action] < 0) {
+        return; // Presses of other actions neither advance nor break a combo
+    }
+
+    history[historyCount & (HISTORY_SIZE - 1)] = timestampNs;
+    historyCount++;
+    state = transitions[state * symbolCount + actionSymbols[action]];
+
+    // Only the patterns that end on this press need their timing checked
+    bool matched = false;
+    for (uint32_t i = outputStart[state]; i < outputStart[state + 1]; i++) {
+        const Pattern& pattern = patterns[outputs[i]];
+        size_t first = historyCount - pattern.length;
+        bool inTime = true;
+        for (size_t press = 1; press < pattern.length && inTime; press++) {
+            uint64_t previous = history[(first + press - 1) & (HISTORY_SIZE - 1)];
+            uint64_t current = history[(first + press) & (HISTORY_SIZE - 1)];
+            inTime = current - previous <= patternLimits[pattern.firstLimit + press - 1];
+        }
+        if (inTime && std::find(pending.begin(), pending.end(), pattern.combo) == pending.end()) {
+            pending.push_back(pattern.combo);
+            matched = true;
+        }
+    }
+
+    // A completed combo consumes its presses
+    if (matched) {
+        state = 0;
+    }
+}
+
+void ComboMatcher::update() {
+    MEMORY_TAG_SCOPE(Memory::Tag::Input);
+    triggered.swap(pending);
+    pending.clear();
+
+    for (ComboId combo : triggered) {
+        if (comboCallbacks[combo]) {
+            comboCallbacks[combo]();
+        }
+    }
+}
+
+bool ComboMatcher::isComboTriggered(ComboId combo) const {
+    return std::find(triggered.begin(), triggered.end(), combo) != triggered.end();
+}
+
+ComboId ComboMatcher::getComboId(const std::string& name) const {
+    auto it = comboIds.find(name);
+    return it != comboIds.end() ? it->second : INVALID_COMBO;
+}
+
+void ComboMatcher::registerComboCallback(ComboId combo, std::function<void()> callback) {
+    if (combo < comboCallbacks.size()) {
+        comboCallbacks[combo] = std::move(callback);
+    }
+}
+
+} // namespace Keyboard
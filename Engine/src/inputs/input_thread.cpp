@@ -0,0 +1,132 @@
+#include <inputs/input_thread.hpp>
+#include <threading/threading.hpp>
+#include <profiling/profiler.hpp>
+#include <iostream>
+
+bool InputEventQueue::push(const SDL_Event& event) {
+    size_t writeIndex = tail.load(std::memory_order_relaxed);
+    if (writeIndex - head.load(std::memory_order_acquire) >= CAPACITY) {
+        return false; // full
+    }
+    events[writeIndex & (CAPACITY - 1)] = event;
+    tail.store(writeIndex + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputEventQueue::pop(SDL_Event& event) {
+    size_t readIndex = head.load(std::memory_order_relaxed);
+    if (readIndex == tail.load(std::memory_order_acquire)) {
+        return false; // empty
+    }
+    event = events[readIndex & (CAPACITY - 1)];
+    head.store(readIndex + 1, std::memory_order_release);
+    return true;
+}
+
+InputThread::~InputThread() {
+    stop();
+}
+
+void InputThread::addListener(Listener listener) {
+    listeners.push_back(std::move(listener));
+}
+
+bool InputThread::start() {
+    if (isRunning()) {
+        return true;
+    }
+
+    wakeup = SDL_CreateSemaphore(0);
+    if (!wakeup) {
+        std::cerr << "Failed to create input thread semaphore: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    running.store(true, std::memory_order_release);
+    thread = Threading::createThread(Threading::configForRole(Threading::ThreadRole::Input, "input"),
+                                     [this]() { threadMain(); });
+
+    // The watch sees every event as the main thread pumps it: in processEvents
+    // and while FrameScheduler::sleepUntil idles
+    if (!SDL_AddEventWatch(EventWatch, this)) {
+        std::cerr << "Failed to add input event watch: " << SDL_GetError() << std::endl;
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void InputThread::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    SDL_RemoveEventWatch(EventWatch, this);
+    running.store(false, std::memory_order_release);
+    SDL_SignalSemaphore(wakeup);
+    if (thread.joinable()) {
+        thread.join();
+    }
+    SDL_DestroySemaphore(wakeup);
+    wakeup = nullptr;
+}
+
+void InputThread::submit(const SDL_Event& event) {
+    if (!isLatencyCritical(event.type)) {
+        return;
+    }
+
+    if (!isRunning()) {
+        dispatch(event);
+        return;
+    }
+
+    if (queue.push(event)) {
+        SDL_SignalSemaphore(wakeup);
+    } else {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool InputThread::isLatencyCritical(uint32_t eventType) {
+    return eventType == SDL_EVENT_KEY_DOWN || eventType == SDL_EVENT_KEY_UP;
+}
+
+bool SDLCALL InputThread::EventWatch(void* userdata, SDL_Event* event) {
+    // Key events are only produced on the video thread, which keeps the queue single-producer
+    InputThread* inputThread = static_cast<InputThread*>(userdata);
+    if (inputThread->liveInput.load(std::memory_order_acquire)) {
+        inputThread->submit(*event);
+    }
+    return true;
+}
+
+void InputThread::threadMain() {
+    SDL_Event event;
+    while (isRunning()) {
+        SDL_WaitSemaphore(wakeup);
+        while (queue.pop(event)) {
+            dispatch(event);
+        }
+    }
+
+    // Deliver anything queued before shutdown
+    while (queue.pop(event)) {
+        dispatch(event);
+    }
+}
+
+void InputThread::dispatch(const SDL_Event& event) {
+    PROFILE_SCOPE("InputThread::dispatch");
+    uint64_t now = SDL_GetTicksNS();
+    if (event.common.timestamp != 0 && now > event.common.timestamp) {
+        uint64_t latency = now - event.common.timestamp;
+        uint64_t worst = maxDispatchLatencyNs.load(std::memory_order_relaxed);
+        while (latency > worst && !maxDispatchLatencyNs.compare_exchange_weak(worst, latency, std::memory_order_relaxed)) {
+        }
+    }
+
+    for (const Listener& listener : listeners) {
+        listener(event);
+    }
+}
@@ -1,26 +1,68 @@
 #include <inputs/keyboard.hpp>
+#include <inputs/key_names.hpp>
+#include <memory/memory_tracker.hpp>
+#include <logging/logger.hpp>
 #include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <map>
 #include <string>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Verbose input tracing is compiled out of production builds
+#ifndef KEYBOARD_TRACE
+#if defined(PRODUCTION_BUILD) && PRODUCTION_BUILD
+#define KEYBOARD_TRACE 0
+#else
+#define KEYBOARD_TRACE 1
+#endif
+#endif
+
 namespace Keyboard {
 
+namespace {
+    // Index of the lowest set bit (bits must be non-zero)
+    inline int lowestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+}
+
 KeyboardManager Input;
 
 KeyboardManager::KeyboardManager(const std::string& configFile) : configFilePath(configFile) {
+    // Start from SDL's default layout; real events refine these tables
+    for (SDL_Keycode key = 0; key < asciiScancodes.size(); key++) {
+        asciiScancodes[key] = SDL_GetScancodeFromKey(key, nullptr);
+    }
+    for (int scancode = 0; scancode < SDL_SCANCODE_COUNT; scancode++) {
+        scancodeKeycodes[scancode] = SDL_GetKeyFromScancode(static_cast<SDL_Scancode>(scancode), SDL_KMOD_NONE, false);
+    }
+    
     loadConfiguration(configFile);
 }
 
 bool KeyboardManager::loadConfiguration(const std::string& configFile) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Input);
     std::ifstream file(configFile);
     if (!file.is_open()) {
-        SDL_Log("Failed to open keyboard configuration file: %s", configFile.c_str());
+        LOG_ERROR(Log::Category::Input, "Failed to open keyboard configuration file: {}", configFile);
         return false;
     }
 
-    actionMappings.clear();
+    // Unbind every action but keep the interned ids so handles stay valid
+    for (auto& mapping : actionMappings) {
+        mapping.bindings.clear();
+    }
+    keyActionsDirty = true;
     
     std::string line;
     while (std::getline(file, line)) {
@@ -29,14 +71,21 @@ bool KeyboardManager::loadConfiguration(const std::string& configFile) {
             continue;
         }
         
+        // ActionName followed by any number of bindings (NONE = unbound slot)
         std::istringstream iss(line);
-        std::string actionName, primaryKeyStr, alternateKeyStr;
+        std::string actionName, token;
+        if (!(iss >> actionName)) {
+            continue;
+        }
         
-        if (iss >> actionName >> primaryKeyStr >> alternateKeyStr) {
-            SDL_Keycode primaryKey = stringToKeycode(primaryKeyStr);
-            SDL_Keycode alternateKey = stringToKeycode(alternateKeyStr);
-            
-            mapAction(actionName, primaryKey, alternateKey);
+        registerAction(actionName);
+        while (iss >> token) {
+            InputBinding binding;
+            if (parseBinding(token, binding)) {
+                bindAction(actionName, binding);
+            } else if (token != "NONE") {
+                LOG_WARNING(Log::Category::Input, "Unknown binding '{}' for action {}", token, actionName);
+            }
         }
     }
     
@@ -49,203 +98,469 @@ bool KeyboardManager::saveConfiguration(const std::string& configFile) {
     
     std::ofstream file(filePath);
     if (!file.is_open()) {
-        SDL_Log("Failed to open keyboard configuration file for writing: %s", filePath.c_str());
+        LOG_ERROR(Log::Category::Input, "Failed to open keyboard configuration file for writing: {}", filePath);
         return false;
     }
     
     file << "# Keyboard Configuration File\n";
-    file << "# Format: ActionName PrimaryKey AlternateKey\n\n";
+    file << "# Format: ActionName Binding [Binding...]\n";
+    file << "# Bindings: key names, MOUSE_LEFT/RIGHT/MIDDLE/X1/X2, PAD:<button>, AXIS:<axis>+|-[@deadzone]\n\n";
     
-    for (const auto& [actionName, mapping] : actionMappings) {
-        file << actionName << " " 
-             << keycodeToString(mapping.primaryKey) << " " 
-             << keycodeToString(mapping.alternateKey) << "\n";
+    for (const auto& mapping : actionMappings) {
+        if (mapping.bindings.empty()) {
+            continue; // Registered but unbound
+        }
+        file << mapping.actionName;
+        for (const InputBinding& binding : mapping.bindings) {
+            file << " " << bindingToString(binding);
+        }
+        // Keep the two-key layout for actions with a single binding
+        if (mapping.bindings.size() == 1) {
+            file << " NONE";
+        }
+        file << "\n";
     }
     
     return true;
 }
 
 void KeyboardManager::handleEvent(const SDL_Event& event) {
-    if (event.type == SDL_EVENT_KEY_DOWN) {
-        SDL_Keycode key = event.key.key;
-        
-        // Check if this is a new key and we're at the limit
-        if (keyStates.find(key) == keyStates.end() && keyStates.size() >= MAX_KEY_STATES) {
-            // Remove a key that's in RELEASED state (prioritize those)
-            bool removed = false;
-            for (auto it = keyStates.begin(); it != keyStates.end(); ) {
-                if (it->second == KeyState::RELEASED) {
-                    SDL_Log("Removing old released key: %s to make room for: %s", 
-                           keycodeToString(it->first).c_str(), keycodeToString(key).c_str());
-                    it = keyStates.erase(it);
-                    removed = true;
+    MEMORY_TAG_SCOPE(Memory::Tag::Input);
+    switch (event.type) {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+            break;
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            if (event.button.button >= 1 && event.button.button <= Controls::MOUSE_BUTTON_COUNT) {
+                setControlValue(Controls::MOUSE_BASE + event.button.button - 1, event.button.down ? 1.0f : 0.0f, event.common.timestamp);
+            }
+            return;
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+            if (event.gbutton.button < SDL_GAMEPAD_BUTTON_COUNT) {
+                setControlValue(Controls::GAMEPAD_BUTTON_BASE + event.gbutton.button, event.gbutton.down ? 1.0f : 0.0f, event.common.timestamp);
+            }
+            return;
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            if (event.gaxis.axis < SDL_GAMEPAD_AXIS_COUNT) {
+                // Each axis is split into a positive and a negative half
+                float value = event.gaxis.value >= 0 ? event.gaxis.value / 32767.0f : event.gaxis.value / 32768.0f;
+                int control = Controls::GAMEPAD_AXIS_BASE + event.gaxis.axis * 2;
+                setControlValue(control, value > 0.0f ? value : 0.0f, event.common.timestamp);
+                setControlValue(control + 1, value < 0.0f ? -value : 0.0f, event.common.timestamp);
+            }
+            return;
+        case SDL_EVENT_GAMEPAD_ADDED:
+            if (SDL_Gamepad* gamepad = SDL_OpenGamepad(event.gdevice.which)) {
+                gamepads.push_back(gamepad);
+            }
+            return;
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            for (auto it = gamepads.begin(); it != gamepads.end(); ++it) {
+                if (SDL_GetGamepadID(*it) == event.gdevice.which) {
+                    SDL_CloseGamepad(*it);
+                    gamepads.erase(it);
                     break;
-                } else {
-                    ++it;
                 }
             }
-            
-            // If no RELEASED keys, remove the first key (oldest)
-            if (!removed && !keyStates.empty()) {
-                auto it = keyStates.begin();
-                SDL_Log("Removing oldest key: %s to make room for: %s", 
-                       keycodeToString(it->first).c_str(), keycodeToString(key).c_str());
-                keyStates.erase(it);
-            }
-        }
-        
-        // Update state
-        if (keyStates.find(key) == keyStates.end() || 
-            keyStates[key] == KeyState::RELEASED || 
-            keyStates[key] == KeyState::JUST_RELEASED) {
-            keyStates[key] = KeyState::JUST_PRESSED;
+            // Controls are shared by all gamepads, so release them all
+            releaseGamepadControls(event.common.timestamp);
+            return;
+        default:
+            return;
+    }
+    
+    SDL_Keycode key = event.key.key;
+    SDL_Scancode scancode = event.key.scancode;
+    if (scancode <= SDL_SCANCODE_UNKNOWN || scancode >= SDL_SCANCODE_COUNT) {
+        return;
+    }
+    
+    // Keep the translation tables in sync with the active layout
+    scancodeKeycodes[scancode] = key;
+    if (key < asciiScancodes.size()) {
+        asciiScancodes[key] = scancode;
+    }
+    
+    if (event.type == SDL_EVENT_KEY_DOWN) {
+        // Ignore auto-repeat of a key that is already down
+        if (!liveKeys.test(scancode)) {
+            liveKeys.set(scancode);
+            pressedEvents.set(scancode);
             
             // Trigger callbacks for actions mapped to this key
-            for (auto& [name, mapping] : actionMappings) {
-                if (mapping.primaryKey == key || mapping.alternateKey == key) {
-                    if (mapping.pressCallback) {
-                        mapping.pressCallback();
-                    }
+            if (const std::vector<ActionId>* actions = actionsForKey(key)) {
+                for (ActionId action : *actions) {
+                    notifyActionPressed(action, event.common.timestamp);
                 }
             }
         }
     } 
-    else if (event.type == SDL_EVENT_KEY_UP) {
-        SDL_Keycode key = event.key.key;
+    else if (liveKeys.test(scancode)) {
+        liveKeys.reset(scancode);
+        releasedEvents.set(scancode);
         
-        // Check if this is a new key and we're at the limit
-        if (keyStates.find(key) == keyStates.end() && keyStates.size() >= MAX_KEY_STATES) {
-            // Remove a key that's in RELEASED state (prioritize those)
-            bool removed = false;
-            for (auto it = keyStates.begin(); it != keyStates.end(); ) {
-                if (it->second == KeyState::RELEASED) {
-                    SDL_Log("Removing old released key: %s to make room for: %s", 
-                           keycodeToString(it->first).c_str(), keycodeToString(key).c_str());
-                    it = keyStates.erase(it);
-                    removed = true;
-                    break;
-                } else {
-                    ++it;
+        // Trigger callbacks for actions mapped to this key
+        if (const std::vector<ActionId>* actions = actionsForKey(key)) {
+            for (ActionId action : *actions) {
+                if (actionMappings[action].releaseCallback) {
+                    actionMappings[action].releaseCallback();
                 }
             }
-            
-            // If no RELEASED keys, remove the first key (oldest)
-            if (!removed && !keyStates.empty()) {
-                auto it = keyStates.begin();
-                SDL_Log("Removing oldest key: %s to make room for: %s", 
-                       keycodeToString(it->first).c_str(), keycodeToString(key).c_str());
-                keyStates.erase(it);
-            }
         }
-        
-        // Update state
-        if (keyStates.find(key) != keyStates.end() &&
-           (keyStates[key] == KeyState::PRESSED || 
-            keyStates[key] == KeyState::JUST_PRESSED)) {
-            keyStates[key] = KeyState::JUST_RELEASED;
+    }
+}
+
+void KeyboardManager::update() {
+    MEMORY_TAG_SCOPE(Memory::Tag::Input);
+    // Flip the frame buffers and derive the edges for the new frame
+    previousKeys = currentKeys;
+    currentKeys = liveKeys;
+    for (size_t w = 0; w < KeyBits::WORD_COUNT; w++) {
+        justPressedKeys.words[w] = (currentKeys.words[w] & ~previousKeys.words[w]) | pressedEvents.words[w];
+        justReleasedKeys.words[w] = (previousKeys.words[w] & ~currentKeys.words[w]) | releasedEvents.words[w];
+    }
+    pressedEvents.clear();
+    releasedEvents.clear();
+    
+#if KEYBOARD_TRACE
+    if (traceLevel != TraceLevel::Off) {
+        traceFrame();
+    }
+#endif
+    
+    updateActionStates();
+    
+    // Handle hold callbacks, once per held action
+    for (size_t w = 0; w < actionPressed.words.size(); w++) {
+        uint64_t bits = actionPressed.words[w];
+        while (bits) {
+            int bit = lowestBit(bits);
+            bits &= bits - 1;
             
-            // Trigger callbacks for actions mapped to this key
-            for (auto& [name, mapping] : actionMappings) {
-                if (mapping.primaryKey == key || mapping.alternateKey == key) {
-                    if (mapping.releaseCallback) {
-                        mapping.releaseCallback();
-                    }
-                }
+            ActionMapping& mapping = actionMappings[w * 64 + bit];
+            if (mapping.holdCallback) {
+                mapping.holdCallback();
             }
         }
     }
 }
 
-void KeyboardManager::update() {
-    for (auto& [key, state] : keyStates) {
-        std::string keyName = keycodeToString(key);
-        if (state == KeyState::JUST_PRESSED) {
-            SDL_Log("Key %s JUST_PRESSED", keyName.c_str());
-            state = KeyState::PRESSED;
-        } 
-        else if (state == KeyState::JUST_RELEASED) {
-            state = KeyState::RELEASED;
+void KeyboardManager::traceFrame() const {
+    for (size_t w = 0; w < KeyBits::WORD_COUNT; w++) {
+        uint64_t bits = justPressedKeys.words[w] | justReleasedKeys.words[w];
+        if (traceLevel == TraceLevel::Held) {
+            bits |= currentKeys.words[w];
         }
-        
-        // Handle hold callbacks
-        if (state == KeyState::PRESSED) {
-            SDL_Log("Key %s PRESSED", keyName.c_str());
+        while (bits) {
+            int bit = lowestBit(bits);
+            bits &= bits - 1;
             
-            for (auto& [name, mapping] : actionMappings) {
-                if ((mapping.primaryKey == key || mapping.alternateKey == key) && mapping.holdCallback) {
-                    mapping.holdCallback();
+            SDL_Scancode scancode = static_cast<SDL_Scancode>(w * 64 + bit);
+            std::string_view keyName = keycodeToString(scancodeKeycodes[scancode]);
+            if (justPressedKeys.test(scancode)) {
+                LOG_INFO(Log::Category::Input, "Key {} JUST_PRESSED", keyName);
+            }
+            if (justReleasedKeys.test(scancode)) {
+                LOG_INFO(Log::Category::Input, "Key {} JUST_RELEASED", keyName);
+            }
+            if (traceLevel == TraceLevel::Held && currentKeys.test(scancode)) {
+                LOG_INFO(Log::Category::Input, "Key {} PRESSED", keyName);
+            }
+        }
+    }
+}
+
+TraceLevel KeyboardManager::parseTraceLevel(const std::string& value) {
+    if (value == "edges") return TraceLevel::Edges;
+    if (value == "held") return TraceLevel::Held;
+    return TraceLevel::Off;
+}
+
+void KeyboardManager::rebuildKeyActions() {
+    keyActions.clear();
+    for (auto& bindings : controlActions) {
+        bindings.clear();
+    }
+    
+    for (size_t id = 0; id < actionMappings.size(); id++) {
+        ActionId action = static_cast<ActionId>(id);
+        for (const InputBinding& binding : actionMappings[id].bindings) {
+            if (binding.source == InputSource::Key) {
+                std::vector<ActionId>& actions = keyActions[binding.code];
+                if (std::find(actions.begin(), actions.end(), action) == actions.end()) {
+                    actions.push_back(action);
+                }
+            } else {
+                int control = controlIndex(binding);
+                if (control >= 0) {
+                    controlActions[control].push_back(ControlBinding{action, binding.deadzone});
                 }
             }
         }
     }
+    keyActionsDirty = false;
 }
 
-KeyState KeyboardManager::getKeyState(SDL_Keycode keyCode) const {
-    auto it = keyStates.find(keyCode);
-    if (it != keyStates.end()) {
-        return it->second;
+const std::vector<ActionId>* KeyboardManager::actionsForKey(SDL_Keycode key) {
+    if (keyActionsDirty) {
+        rebuildKeyActions();
     }
-    return KeyState::RELEASED;
+    auto it = keyActions.find(key);
+    return it != keyActions.end() ? &it->second : nullptr;
 }
 
-bool KeyboardManager::isKeyPressed(SDL_Keycode keyCode) const {
-    KeyState state = getKeyState(keyCode);
-    return state == KeyState::PRESSED || state == KeyState::JUST_PRESSED;
+const std::vector<KeyboardManager::ControlBinding>& KeyboardManager::actionsForControl(int control) {
+    if (keyActionsDirty) {
+        rebuildKeyActions();
+    }
+    return controlActions[control];
 }
 
-bool KeyboardManager::isKeyJustPressed(SDL_Keycode keyCode) const {
-    return getKeyState(keyCode) == KeyState::JUST_PRESSED;
+namespace {
+    // Rescale so the value starts at 0 on the edge of the deadzone
+    inline float applyDeadzone(float value, float deadzone) {
+        return value > deadzone ? (value - deadzone) / (1.0f - deadzone) : 0.0f;
+    }
 }
 
-bool KeyboardManager::isKeyJustReleased(SDL_Keycode keyCode) const {
-    return getKeyState(keyCode) == KeyState::JUST_RELEASED;
+void KeyboardManager::setControlValue(int control, float value, uint64_t timestampNs) {
+    float previous = controlValues[control];
+    if (value == previous) {
+        return;
+    }
+    controlValues[control] = value;
+    
+    uint64_t bit = uint64_t(1) << control;
+    if (value > 0.0f) {
+        activeControls |= bit;
+        if (previous == 0.0f) {
+            controlPressEvents |= bit;
+        }
+    } else {
+        activeControls &= ~bit;
+        // Buttons pressed and released within one frame still count as a press;
+        // axes are not treated this way so noise around the deadzone is ignored
+        if ((controlPressEvents & bit) && control < Controls::GAMEPAD_AXIS_BASE) {
+            tappedControls |= bit;
+        }
+    }
+    
+    // Fire callbacks for bindings whose value crossed the press threshold
+    for (const ControlBinding& binding : actionsForControl(control)) {
+        bool wasPressed = applyDeadzone(previous, binding.deadzone) >= Controls::PRESS_THRESHOLD;
+        bool isPressed = applyDeadzone(value, binding.deadzone) >= Controls::PRESS_THRESHOLD;
+        ActionMapping& mapping = actionMappings[binding.action];
+        if (isPressed && !wasPressed) {
+            notifyActionPressed(binding.action, timestampNs);
+        } else if (wasPressed && !isPressed && mapping.releaseCallback) {
+            mapping.releaseCallback();
+        }
+    }
 }
 
-bool KeyboardManager::mapAction(const std::string& actionName, SDL_Keycode primaryKey, SDL_Keycode alternateKey) {
-    // Check if we're at the limit for action mappings and this is a new action
-    if (actionMappings.find(actionName) == actionMappings.end() && actionMappings.size() >= MAX_KEY_STATES) {
-        // Remove the first action mapping to make room
-        if (!actionMappings.empty()) {
-            auto it = actionMappings.begin();
-            SDL_Log("Removing old action mapping: %s to make room for: %s", 
-                   it->first.c_str(), actionName.c_str());
-            actionMappings.erase(it);
+void KeyboardManager::notifyActionPressed(ActionId action, uint64_t timestampNs) {
+    if (actionMappings[action].pressCallback) {
+        actionMappings[action].pressCallback();
+    }
+    
+    // Synthetic events may carry no timestamp
+    if (!actionPressListeners.empty()) {
+        uint64_t timestamp = timestampNs ? timestampNs : SDL_GetTicksNS();
+        for (const ActionPressListener& listener : actionPressListeners) {
+            listener(action, timestamp);
         }
     }
+}
 
-    actionMappings[actionName] = ActionMapping{
-        actionName,
-        primaryKey,
-        alternateKey
-    };
-    return true;
+void KeyboardManager::addActionPressListener(ActionPressListener listener) {
+    actionPressListeners.push_back(std::move(listener));
 }
 
-bool KeyboardManager::isActionPressed(const std::string& actionName) const {
-    auto it = actionMappings.find(actionName);
-    if (it != actionMappings.end()) {
-        return isKeyPressed(it->second.primaryKey) || 
-               (it->second.alternateKey != SDLK_UNKNOWN && isKeyPressed(it->second.alternateKey));
+void KeyboardManager::releaseGamepadControls(uint64_t timestampNs) {
+    for (int control = Controls::GAMEPAD_BUTTON_BASE; control < Controls::COUNT; control++) {
+        setControlValue(control, 0.0f, timestampNs);
     }
-    return false;
 }
 
-bool KeyboardManager::isActionJustPressed(const std::string& actionName) const {
-    auto it = actionMappings.find(actionName);
-    if (it != actionMappings.end()) {
-        return isKeyJustPressed(it->second.primaryKey) || 
-               (it->second.alternateKey != SDLK_UNKNOWN && isKeyJustPressed(it->second.alternateKey));
+void KeyboardManager::accumulateAction(ActionId action, float value) {
+    float& current = actionValues[action];
+    if (current == 0.0f && value > 0.0f) {
+        valuedActions.push_back(action);
+    }
+    if (value > current) {
+        current = value;
+    }
+}
+
+void KeyboardManager::updateActionStates() {
+    // Reset only the actions that had a value last frame
+    for (ActionId action : valuedActions) {
+        actionValues[action] = 0.0f;
+    }
+    valuedActions.clear();
+    
+    std::swap(actionPreviousPressed.words, actionPressed.words);
+    actionPressed.clear();
+    actionJustPressed.clear(); // collects taps shorter than a frame first
+    
+    // Only keys that are down or were tapped this frame can affect an action
+    for (size_t w = 0; w < KeyBits::WORD_COUNT; w++) {
+        uint64_t tapped = justPressedKeys.words[w] & ~currentKeys.words[w];
+        uint64_t bits = currentKeys.words[w] | tapped;
+        while (bits) {
+            int bit = lowestBit(bits);
+            bits &= bits - 1;
+            
+            SDL_Scancode scancode = static_cast<SDL_Scancode>(w * 64 + bit);
+            const std::vector<ActionId>* actions = actionsForKey(scancodeKeycodes[scancode]);
+            if (!actions) {
+                continue;
+            }
+            
+            bool pressed = currentKeys.test(scancode);
+            for (ActionId action : *actions) {
+                if (pressed) {
+                    accumulateAction(action, 1.0f);
+                } else {
+                    actionJustPressed.set(action);
+                }
+            }
+        }
+    }
+    
+    // Same for mouse and gamepad controls
+    uint64_t controls = activeControls | tappedControls;
+    while (controls) {
+        int control = lowestBit(controls);
+        controls &= controls - 1;
+        
+        bool tapped = (tappedControls >> control) & 1u;
+        for (const ControlBinding& binding : actionsForControl(control)) {
+            float value = applyDeadzone(controlValues[control], binding.deadzone);
+            if (value > 0.0f) {
+                accumulateAction(binding.action, value);
+            } else if (tapped) {
+                actionJustPressed.set(binding.action);
+            }
+        }
+    }
+    controlPressEvents = 0;
+    tappedControls = 0;
+    
+    for (ActionId action : valuedActions) {
+        if (actionValues[action] >= Controls::PRESS_THRESHOLD) {
+            actionPressed.set(action);
+        }
+    }
+    
+    // Edges: state changes since last frame, plus taps that started and ended within it
+    for (size_t w = 0; w < actionPressed.words.size(); w++) {
+        uint64_t pressed = actionPressed.words[w];
+        uint64_t previous = actionPreviousPressed.words[w];
+        uint64_t tapped = actionJustPressed.words[w] & ~pressed;
+        actionJustPressed.words[w] = (pressed & ~previous) | tapped;
+        actionJustReleased.words[w] = (previous & ~pressed) | tapped;
+    }
+}
+
+KeyState KeyboardManager::getKeyState(SDL_Scancode scancode) const {
+    if (justPressedKeys.test(scancode)) {
+        return KeyState::JUST_PRESSED;
+    }
+    if (justReleasedKeys.test(scancode)) {
+        return KeyState::JUST_RELEASED;
+    }
+    return currentKeys.test(scancode) ? KeyState::PRESSED : KeyState::RELEASED;
+}
+
+ActionId KeyboardManager::registerAction(const std::string& actionName) {
+    auto it = actionIds.find(actionName);
+    if (it != actionIds.end()) {
+        return it->second;
+    }
+    
+    if (actionMappings.size() >= INVALID_ACTION) {
+        LOG_ERROR(Log::Category::Input, "Too many actions, cannot register: {}", actionName);
+        return INVALID_ACTION;
+    }
+    
+    ActionId id = static_cast<ActionId>(actionMappings.size());
+    ActionMapping mapping;
+    mapping.actionName = actionName;
+    actionMappings.push_back(std::move(mapping));
+    actionIds.emplace(actionName, id);
+    
+    actionValues.resize(actionMappings.size(), 0.0f);
+    valuedActions.reserve(actionMappings.size());
+    actionPressed.resize(actionMappings.size());
+    actionPreviousPressed.resize(actionMappings.size());
+    actionJustPressed.resize(actionMappings.size());
+    actionJustReleased.resize(actionMappings.size());
+    return id;
+}
+
+ActionId KeyboardManager::mapAction(const std::string& actionName, SDL_Keycode primaryKey, SDL_Keycode alternateKey) {
+    ActionId id = registerAction(actionName);
+    if (id == INVALID_ACTION) {
+        return id;
+    }
+    
+    // Replace the key bindings, keep mouse and gamepad bindings
+    std::vector<InputBinding>& bindings = actionMappings[id].bindings;
+    bindings.erase(std::remove_if(bindings.begin(), bindings.end(),
+                                  [](const InputBinding& b) { return b.source == InputSource::Key; }),
+                   bindings.end());
+    for (SDL_Keycode key : {primaryKey, alternateKey}) {
+        if (key != SDLK_UNKNOWN) {
+            InputBinding binding;
+            binding.code = static_cast<int32_t>(key);
+            bindings.push_back(binding);
+        }
     }
-    return false;
+    keyActionsDirty = true;
+    return id;
+}
+
+ActionId KeyboardManager::bindAction(const std::string& actionName, const InputBinding& binding) {
+    ActionId id = registerAction(actionName);
+    if (id != INVALID_ACTION) {
+        actionMappings[id].bindings.push_back(binding);
+        keyActionsDirty = true;
+    }
+    return id;
+}
+
+ActionId KeyboardManager::getActionId(const std::string& actionName) const {
+    auto it = actionIds.find(actionName);
+    return it != actionIds.end() ? it->second : INVALID_ACTION;
+}
+
+bool KeyboardManager::isActionPressed(const std::string& actionName) const {
+    return isActionPressed(getActionId(actionName));
+}
+
+bool KeyboardManager::isActionJustPressed(const std::string& actionName) const {
+    return isActionJustPressed(getActionId(actionName));
 }
 
 bool KeyboardManager::isActionJustReleased(const std::string& actionName) const {
-    auto it = actionMappings.find(actionName);
-    if (it != actionMappings.end()) {
-        return isKeyJustReleased(it->second.primaryKey) || 
-               (it->second.alternateKey != SDLK_UNKNOWN && isKeyJustReleased(it->second.alternateKey));
+    return isActionJustReleased(getActionId(actionName));
+}
+
+void KeyboardManager::registerActionCallback(
+    ActionId action,
+    std::function<void()> pressCallback,
+    std::function<void()> releaseCallback,
+    std::function<void()> holdCallback) {
+    
+    if (action < actionMappings.size()) {
+        ActionMapping& mapping = actionMappings[action];
+        if (pressCallback) mapping.pressCallback = pressCallback;
+        if (releaseCallback) mapping.releaseCallback = releaseCallback;
+        if (holdCallback) mapping.holdCallback = holdCallback;
     }
-    return false;
 }
 
 void KeyboardManager::registerActionCallback(
@@ -254,146 +569,129 @@ void KeyboardManager::registerActionCallback(
     std::function<void()> releaseCallback,
     std::function<void()> holdCallback) {
     
-    auto it = actionMappings.find(actionName);
-    if (it != actionMappings.end()) {
-        if (pressCallback) it->second.pressCallback = pressCallback;
-        if (releaseCallback) it->second.releaseCallback = releaseCallback;
-        if (holdCallback) it->second.holdCallback = holdCallback;
-    }
-}
-
-SDL_Keycode KeyboardManager::stringToKeycode(const std::string& keyName) {
-    // Standard keys
-    if (keyName == "ESCAPE") return SDLK_ESCAPE;
-    if (keyName == "RETURN") return SDLK_RETURN;
-    if (keyName == "SPACE") return SDLK_SPACE;
-    if (keyName == "TAB") return SDLK_TAB;
-    if (keyName == "BACKSPACE") return SDLK_BACKSPACE;
-    
-    // Letters
-    if (keyName == "A") return SDLK_A;
-    if (keyName == "B") return SDLK_B;
-    if (keyName == "C") return SDLK_C;
-    if (keyName == "D") return SDLK_D;
-    if (keyName == "E") return SDLK_E;
-    if (keyName == "F") return SDLK_F;
-    if (keyName == "G") return SDLK_G;
-    if (keyName == "H") return SDLK_H;
-    if (keyName == "I") return SDLK_I;
-    if (keyName == "J") return SDLK_J;
-    if (keyName == "K") return SDLK_K;
-    if (keyName == "L") return SDLK_L;
-    if (keyName == "M") return SDLK_M;
-    if (keyName == "N") return SDLK_N;
-    if (keyName == "O") return SDLK_O;
-    if (keyName == "P") return SDLK_P;
-    if (keyName == "Q") return SDLK_Q;
-    if (keyName == "R") return SDLK_R;
-    if (keyName == "S") return SDLK_S;
-    if (keyName == "T") return SDLK_T;
-    if (keyName == "U") return SDLK_U;
-    if (keyName == "V") return SDLK_V;
-    if (keyName == "W") return SDLK_W;
-    if (keyName == "X") return SDLK_X;
-    if (keyName == "Y") return SDLK_Y;
-    if (keyName == "Z") return SDLK_Z;
-
-    
-    // Function keys
-    if (keyName == "F1") return SDLK_F1;
-    if (keyName == "F2") return SDLK_F2;
-    if (keyName == "F3") return SDLK_F3;
-    if (keyName == "F4") return SDLK_F4;
-    if (keyName == "F5") return SDLK_F5;
-    if (keyName == "F6") return SDLK_F6;
-    if (keyName == "F7") return SDLK_F7;
-    if (keyName == "F8") return SDLK_F8;
-    if (keyName == "F9") return SDLK_F9;
-    if (keyName == "F10") return SDLK_F10;
-    if (keyName == "F11") return SDLK_F11;
-    if (keyName == "F12") return SDLK_F12;
-    
-    // Arrow keys
-    if (keyName == "UP") return SDLK_UP;
-    if (keyName == "DOWN") return SDLK_DOWN;
-    if (keyName == "LEFT") return SDLK_LEFT;
-    if (keyName == "RIGHT") return SDLK_RIGHT;
-    
-    // Additional keys (add more as needed)
-    if (keyName == "LSHIFT") return SDLK_LSHIFT;
-    if (keyName == "RSHIFT") return SDLK_RSHIFT;
-    if (keyName == "LCTRL") return SDLK_LCTRL;
-    if (keyName == "RCTRL") return SDLK_RCTRL;
-    if (keyName == "LALT") return SDLK_LALT;
-    if (keyName == "RALT") return SDLK_RALT;
-    
-    return SDLK_UNKNOWN;
-}
-
-std::string KeyboardManager::keycodeToString(SDL_Keycode keycode) {
-    switch (keycode) {
-        case SDLK_ESCAPE: return "ESCAPE";
-        case SDLK_RETURN: return "RETURN";
-        case SDLK_SPACE: return "SPACE";
-        case SDLK_TAB: return "TAB";
-        case SDLK_BACKSPACE: return "BACKSPACE";
-        
-        case SDLK_A: return "A";
-        case SDLK_B: return "B";
-        case SDLK_C: return "C";
-        case SDLK_D: return "D";
-        case SDLK_E: return "E";
-        case SDLK_F: return "F";
-        case SDLK_G: return "G";
-        case SDLK_H: return "H";
-        case SDLK_I: return "I";
-        case SDLK_J: return "J";
-        case SDLK_K: return "K";
-        case SDLK_L: return "L";
-        case SDLK_M: return "M";
-        case SDLK_N: return "N";
-        case SDLK_O: return "O";
-        case SDLK_P: return "P";
-        case SDLK_Q: return "Q";
-        case SDLK_R: return "R";
-        case SDLK_S: return "S";
-        case SDLK_T: return "T";
-        case SDLK_U: return "U";
-        case SDLK_V: return "V";
-        case SDLK_W: return "W";
-        case SDLK_X: return "X";
-        case SDLK_Y: return "Y";
-        case SDLK_Z: return "Z";
-        
-        case SDLK_F1: return "F1";
-        case SDLK_F2: return "F2";
-        case SDLK_F3: return "F3";
-        case SDLK_F4: return "F4";
-        case SDLK_F5: return "F5";
-        case SDLK_F6: return "F6";
-        case SDLK_F7: return "F7";
-        case SDLK_F8: return "F8";
-        case SDLK_F9: return "F9";
-        case SDLK_F10: return "F10";
-        case SDLK_F11: return "F11";
-        case SDLK_F12: return "F12";
-        
-        case SDLK_UP: return "UP";
-        case SDLK_DOWN: return "DOWN";
-        case SDLK_LEFT: return "LEFT";
-        case SDLK_RIGHT: return "RIGHT";
-        
-        case SDLK_LSHIFT: return "LSHIFT";
-        case SDLK_RSHIFT: return "RSHIFT";
-        case SDLK_LCTRL: return "LCTRL";
-        case SDLK_RCTRL: return "RCTRL";
-        case SDLK_LALT: return "LALT";
-        case SDLK_RALT: return "RALT";
+    registerActionCallback(getActionId(actionName), pressCallback, releaseCallback, holdCallback);
+}
+
+bool KeyboardManager::parseBinding(const std::string& token, InputBinding& binding) {
+    binding = InputBinding();
+    
+    static const std::pair<const char*, int> MOUSE_BUTTONS[] = {
+        {"MOUSE_LEFT", SDL_BUTTON_LEFT}, {"MOUSE_MIDDLE", SDL_BUTTON_MIDDLE}, {"MOUSE_RIGHT", SDL_BUTTON_RIGHT},
+        {"MOUSE_X1", SDL_BUTTON_X1}, {"MOUSE_X2", SDL_BUTTON_X2}
+    };
+    for (const auto& [name, button] : MOUSE_BUTTONS) {
+        if (token == name) {
+            binding.source = InputSource::MouseButton;
+            binding.code = button;
+            return true;
+        }
+    }
+    
+    if (token.compare(0, 4, "PAD:") == 0) {
+        SDL_GamepadButton button = SDL_GetGamepadButtonFromString(token.c_str() + 4);
+        if (button == SDL_GAMEPAD_BUTTON_INVALID) {
+            return false;
+        }
+        binding.source = InputSource::GamepadButton;
+        binding.code = button;
+        return true;
+    }
+    
+    if (token.compare(0, 5, "AXIS:") == 0) {
+        // AXIS:<name><+|->[@deadzone], e.g. AXIS:leftx-@0.25
+        std::string spec = token.substr(5);
+        binding.deadzone = Controls::DEFAULT_AXIS_DEADZONE;
+        size_t at = spec.find('@');
+        if (at != std::string::npos) {
+            binding.deadzone = SDL_clamp(SDL_atof(spec.c_str() + at + 1), 0.0f, 0.99f);
+            spec.resize(at);
+        }
+        if (spec.empty() || (spec.back() != '+' && spec.back() != '-')) {
+            return false;
+        }
+        binding.negative = spec.back() == '-';
+        spec.pop_back();
         
-        case SDLK_UNKNOWN:
+        SDL_GamepadAxis axis = SDL_GetGamepadAxisFromString(spec.c_str());
+        if (axis == SDL_GAMEPAD_AXIS_INVALID) {
+            return false;
+        }
+        binding.source = InputSource::GamepadAxis;
+        binding.code = axis;
+        return true;
+    }
+    
+    SDL_Keycode key = stringToKeycode(token);
+    if (key == SDLK_UNKNOWN) {
+        return false;
+    }
+    binding.code = static_cast<int32_t>(key);
+    return true;
+}
+
+std::string KeyboardManager::bindingToString(const InputBinding& binding) {
+    switch (binding.source) {
+        case InputSource::Key:
+            return std::string(keycodeToString(static_cast<SDL_Keycode>(binding.code)));
+        case InputSource::MouseButton:
+            switch (binding.code) {
+                case SDL_BUTTON_LEFT: return "MOUSE_LEFT";
+                case SDL_BUTTON_MIDDLE: return "MOUSE_MIDDLE";
+                case SDL_BUTTON_RIGHT: return "MOUSE_RIGHT";
+                case SDL_BUTTON_X1: return "MOUSE_X1";
+                case SDL_BUTTON_X2: return "MOUSE_X2";
+                default: return "NONE";
+            }
+        case InputSource::GamepadButton: {
+            const char* name = SDL_GetGamepadStringForButton(static_cast<SDL_GamepadButton>(binding.code));
+            return name ? std::string("PAD:") + name : "NONE";
+        }
+        case InputSource::GamepadAxis: {
+            const char* name = SDL_GetGamepadStringForAxis(static_cast<SDL_GamepadAxis>(binding.code));
+            if (!name) {
+                return "NONE";
+            }
+            std::string result = std::string("AXIS:") + name + (binding.negative ? "-" : "+");
+            if (binding.deadzone != Controls::DEFAULT_AXIS_DEADZONE) {
+                std::ostringstream deadzone;
+                deadzone << binding.deadzone;
+                result += "@" + deadzone.str();
+            }
+            return result;
+        }
+    }
+    return "NONE";
+}
+
+int KeyboardManager::controlIndex(const InputBinding& binding) {
+    switch (binding.source) {
+        case InputSource::MouseButton:
+            if (binding.code >= 1 && binding.code <= Controls::MOUSE_BUTTON_COUNT) {
+                return Controls::MOUSE_BASE + binding.code - 1;
+            }
+            return -1;
+        case InputSource::GamepadButton:
+            if (binding.code >= 0 && binding.code < SDL_GAMEPAD_BUTTON_COUNT) {
+                return Controls::GAMEPAD_BUTTON_BASE + binding.code;
+            }
+            return -1;
+        case InputSource::GamepadAxis:
+            if (binding.code >= 0 && binding.code < SDL_GAMEPAD_AXIS_COUNT) {
+                return Controls::GAMEPAD_AXIS_BASE + binding.code * 2 + (binding.negative ? 1 : 0);
+            }
+            return -1;
+        case InputSource::Key:
         default:
-            return "UNKNOWN";
+            return -1;
     }
 }
 
+SDL_Keycode KeyboardManager::stringToKeycode(std::string_view keyName) {
+    return KeyNames::fromName(keyName);
+}
+
+std::string_view KeyboardManager::keycodeToString(SDL_Keycode keycode) {
+    return KeyNames::toName(keycode);
+}
+
 } // namespace Keyboard
\ No newline at end of file
@@ -0,0 +1,486 @@
+#include <logging/logger.hpp>
+#include <threading/threading.hpp>
+#include <memory/memory_tracker.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace Log {
+
+namespace Detail {
+    std::atomic<uint8_t> minLevel{static_cast<uint8_t>(Level::Info)};
+    std::atomic<uint32_t> categoryMask{0xFFFFFFFFu};
+}
+
+namespace {
+    constexpr size_t THREAD_NAME_SIZE = 16;
+    // How long the writer sleeps between passes; bounds the delay of a line
+    constexpr int WRITER_PERIOD_MS = 5;
+
+    const char* LEVEL_NAMES[] = {"debug", "info", "warning", "error"};
+    const char* CATEGORY_NAMES[] = {"general", "audio", "input", "renderer"};
+    static_assert(sizeof(CATEGORY_NAMES) / sizeof(CATEGORY_NAMES[0]) == static_cast<size_t>(Category::Count),
+                  "Every category needs a name");
+
+    // Single producer (the owning thread), single consumer (the writer). A
+    // ring outlives its thread: once drained it is handed to the next thread
+    // that logs, so short-lived threads don't allocate one each.
+    struct Ring {
+        static constexpr uint64_t CAPACITY = 512; // power of two
+
+        std::unique_ptr<Record[]> records{new Record[CAPACITY]};
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool> owned{false};
+        std::array<char, THREAD_NAME_SIZE> threadName{}; // guarded by State::registryMutex
+    };
+
+    struct State {
+        std::mutex registryMutex;
+        std::vector<std::unique_ptr<Ring>> rings;
+
+        std::atomic<bool> running{false};
+        std::thread writer;
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        bool atExitRegistered = false;
+
+        // Output, used by the writer or, while it isn't running, by callers
+        std::mutex outputMutex;
+        std::ofstream jsonFile;
+        uint64_t startTicks = 0;
+        uint64_t startNs = 0;
+        uint64_t droppedReported = 0;
+    };
+
+    // Never destroyed, so detached threads can still log during exit
+    State& state() {
+        static State* instance = new State;
+        return *instance;
+    }
+
+    // The calling thread's ring, returned for reuse when the thread exits
+    struct ThreadRing {
+        Ring* ring = nullptr;
+        uint64_t cachedTail = 0;    // the writer's position when last read
+        Record syncRecord;
+
+        ~ThreadRing() {
+            if (ring) {
+                ring->owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ThreadRing threadRing;
+
+    struct Arg {
+        ArgType type;
+        int64_t intValue = 0;
+        uint64_t uintValue = 0;
+        double doubleValue = 0.0;
+        std::string_view text;
+    };
+
+    struct Pending {
+        Record record;
+        std::array<char, THREAD_NAME_SIZE> threadName;
+    };
+
+    void copyThreadName(std::array<char, THREAD_NAME_SIZE>& target, const std::string& name) {
+        size_t length = std::min(name.size(), THREAD_NAME_SIZE - 1);
+        std::memcpy(target.data(), name.data(), length);
+        target[length] = '\0';
+    }
+
+    Ring* claimRing() {
+        MEMORY_TAG_SCOPE(Memory::Tag::General);
+        State& logState = state();
+        std::lock_guard<std::mutex> lock(logState.registryMutex);
+        Ring* claimed = nullptr;
+        for (auto& ring : logState.rings) {
+            // Only drained rings, so a ring's records all come from its current owner
+            if (!ring->owned.load(std::memory_order_acquire) &&
+                ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_acquire)) {
+                claimed = ring.get();
+                break;
+            }
+        }
+        if (!claimed) {
+            logState.rings.push_back(std::make_unique<Ring>());
+            claimed = logState.rings.back().get();
+        }
+        claimed->owned.store(true, std::memory_order_relaxed);
+        copyThreadName(claimed->threadName, Threading::currentThreadName());
+        return claimed;
+    }
+
+    size_t decodeArgs(const Record& record, Arg* args, size_t maxArgs) {
+        size_t count = 0;
+        size_t offset = 0;
+        while (count < record.argCount && count < maxArgs && offset < record.argBytes) {
+            Arg& arg = args[count++];
+            arg.type = static_cast<ArgType>(record.args[offset++]);
+            switch (arg.type) {
+                case ArgType::Int:
+                    std::memcpy(&arg.intValue, record.args + offset, sizeof(int64_t));
+                    offset += sizeof(int64_t);
+                    break;
+                case ArgType::UInt:
+                    std::memcpy(&arg.uintValue, record.args + offset, sizeof(uint64_t));
+                    offset += sizeof(uint64_t);
+                    break;
+                case ArgType::Double:
+                    std::memcpy(&arg.doubleValue, record.args + offset, sizeof(double));
+                    offset += sizeof(double);
+                    break;
+                case ArgType::Bool:
+                    arg.uintValue = record.args[offset];
+                    offset += sizeof(uint8_t);
+                    break;
+                case ArgType::Char:
+                    arg.intValue = static_cast<char>(record.args[offset]);
+                    offset += sizeof(char);
+                    break;
+                case ArgType::String: {
+                    uint16_t length;
+                    std::memcpy(&length, record.args + offset, sizeof(length));
+                    offset += sizeof(length);
+                    arg.text = std::string_view(reinterpret_cast<const char*>(record.args + offset), length);
+                    offset += length;
+                    break;
+                }
+            }
+        }
+        return count;
+    }
+
+    void writeArg(std::ostream& out, const Arg& arg) {
+        switch (arg.type) {
+            case ArgType::Int: out << arg.intValue; break;
+            case ArgType::UInt: out << arg.uintValue; break;
+            case ArgType::Double: out << arg.doubleValue; break;
+            case ArgType::Bool: out << (arg.uintValue ? "true" : "false"); break;
+            case ArgType::Char: out << static_cast<char>(arg.intValue); break;
+            case ArgType::String: out << arg.text; break;
+        }
+    }
+
+    void writeJsonString(std::ostream& out, std::string_view text) {
+        out << '"';
+        for (char c : text) {
+            switch (c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                            << std::dec << std::setfill(' ');
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+    void writeJsonArg(std::ostream& out, const Arg& arg) {
+        switch (arg.type) {
+            case ArgType::Double:
+                if (std::isfinite(arg.doubleValue)) {
+                    out << arg.doubleValue;
+                } else {
+                    out << "null";
+                }
+                break;
+            case ArgType::Char: {
+                char c = static_cast<char>(arg.intValue);
+                writeJsonString(out, std::string_view(&c, 1));
+                break;
+            }
+            case ArgType::String:
+                writeJsonString(out, arg.text);
+                break;
+            default:
+                writeArg(out, arg);
+        }
+    }
+
+    // Caller holds outputMutex
+    void output(const Record& record, uint64_t timestampNs, const char* threadName) {
+        State& logState = state();
+        const Site& site = *record.site;
+
+        Arg args[Record::ARG_BYTES / 2];
+        size_t argCount = decodeArgs(record, args, sizeof(args) / sizeof(args[0]));
+
+        // Substitute the arguments for the {} placeholders; extras are appended
+        std::ostringstream message;
+        size_t nextArg = 0;
+        for (const char* c = site.format; *c; c++) {
+            if (c[0] == '{' && c[1] == '}' && nextArg < argCount) {
+                writeArg(message, args[nextArg++]);
+                c++;
+            } else {
+                message << *c;
+            }
+        }
+        for (; nextArg < argCount; nextArg++) {
+            message << ' ';
+            writeArg(message, args[nextArg]);
+        }
+        if (record.truncated) {
+            message << "...";
+        }
+
+        std::ostringstream line;
+        line << '[' << std::fixed << std::setprecision(3) << std::setw(9) << timestampNs / 1e9 << "] ["
+             << categoryName(site.category) << "] ";
+        if (site.level != Level::Info) {
+            line << levelName(site.level) << ": ";
+        }
+        line << message.str() << '\n';
+        (site.level >= Level::Warning ? std::cerr : std::cout) << line.str();
+
+        if (logState.jsonFile.is_open()) {
+            std::ostream& json = logState.jsonFile;
+            json << "{\"time\":" << std::fixed << std::setprecision(6) << timestampNs / 1e9
+                 << std::defaultfloat << std::setprecision(6)
+                 << ",\"level\":\"" << levelName(site.level)
+                 << "\",\"category\":\"" << categoryName(site.category) << "\",\"thread\":";
+            writeJsonString(json, threadName);
+            json << ",\"format\":";
+            writeJsonString(json, site.format);
+            json << ",\"message\":";
+            writeJsonString(json, message.str());
+            json << ",\"args\":[";
+            for (size_t i = 0; i < argCount; i++) {
+                if (i > 0) {
+                    json << ',';
+                }
+                writeJsonArg(json, args[i]);
+            }
+            json << "]}\n";
+        }
+    }
+
+    // Writer thread: copies every ring's new records out, then formats them
+    void drain(std::vector<Pending>& pending) {
+        State& logState = state();
+        pending.clear();
+        uint64_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(logState.registryMutex);
+            for (auto& ring : logState.rings) {
+                uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+                uint64_t head = ring->head.load(std::memory_order_acquire);
+                for (; tail < head; tail++) {
+                    pending.push_back({ring->records[tail & (Ring::CAPACITY - 1)], ring->threadName});
+                }
+                ring->tail.store(head, std::memory_order_release);
+                dropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Rings are drained one after the other; restore the order of the calls
+        std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+            return a.record.ticks < b.record.ticks;
+        });
+
+        // Ticks to nanoseconds, calibrated over the time since start()
+        uint64_t nowTicks = readProfileTicks();
+        uint64_t nowNs = SDL_GetTicksNS();
+        double nsPerTick = nowTicks > logState.startTicks
+            ? static_cast<double>(nowNs - logState.startNs) / static_cast<double>(nowTicks - logState.startTicks)
+            : 0.0;
+
+        std::lock_guard<std::mutex> lock(logState.outputMutex);
+        for (const Pending& entry : pending) {
+            double sinceStart = static_cast<double>(static_cast<int64_t>(entry.record.ticks - logState.startTicks)) * nsPerTick;
+            output(entry.record, logState.startNs + static_cast<uint64_t>(std::max(sinceStart, 0.0)), entry.threadName.data());
+        }
+        if (dropped > logState.droppedReported) {
+            std::cerr << "Log: " << dropped - logState.droppedReported << " records dropped (ring full)" << std::endl;
+            logState.droppedReported = dropped;
+        }
+        if (!pending.empty()) {
+            std::cout.flush();
+            if (logState.jsonFile.is_open()) {
+                logState.jsonFile.flush();
+            }
+        }
+    }
+
+    void writerMain() {
+        State& logState = state();
+        std::vector<Pending> pending;
+        pending.reserve(Ring::CAPACITY);
+        while (logState.running.load(std::memory_order_acquire)) {
+            drain(pending);
+            std::unique_lock<std::mutex> lock(logState.wakeMutex);
+            logState.wakeCondition.wait_for(lock, std::chrono::milliseconds(WRITER_PERIOD_MS), [&logState]() {
+                return !logState.running.load(std::memory_order_acquire);
+            });
+        }
+        drain(pending);
+    }
+}
+
+namespace Detail {
+    Record* beginRecord() {
+        ThreadRing& local = threadRing;
+        if (!state().running.load(std::memory_order_acquire)) {
+            return &local.syncRecord;
+        }
+        if (!local.ring) {
+            local.ring = claimRing();
+            local.cachedTail = local.ring->tail.load(std::memory_order_acquire);
+        }
+        Ring& ring = *local.ring;
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        if (head - local.cachedTail >= Ring::CAPACITY) {
+            local.cachedTail = ring.tail.load(std::memory_order_acquire);
+            if (head - local.cachedTail >= Ring::CAPACITY) {
+                ring.dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+        return &ring.records[head & (Ring::CAPACITY - 1)];
+    }
+
+    void commitRecord(Record* record) {
+        ThreadRing& local = threadRing;
+        if (record == &local.syncRecord) {
+            std::array<char, THREAD_NAME_SIZE> name;
+            copyThreadName(name, Threading::currentThreadName());
+            std::lock_guard<std::mutex> lock(state().outputMutex);
+            output(*record, SDL_GetTicksNS(), name.data());
+            std::cout.flush();
+            return;
+        }
+        Ring& ring = *local.ring;
+        ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+}
+
+void setLevel(Level level) {
+    Detail::minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void setCategories(uint32_t mask) {
+    Detail::categoryMask.store(mask, std::memory_order_relaxed);
+}
+
+void configure(const std::string& level, const std::string& categories) {
+    bool levelFound = false;
+    for (size_t i = 0; i < sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]); i++) {
+        if (level == LEVEL_NAMES[i]) {
+            setLevel(static_cast<Level>(i));
+            levelFound = true;
+        }
+    }
+    if (!levelFound) {
+        std::cerr << "Unknown log level '" << level << "', keeping " << levelName(static_cast<Level>(Detail::minLevel.load())) << std::endl;
+    }
+
+    if (categories == "all") {
+        setCategories(0xFFFFFFFFu);
+        return;
+    }
+    uint32_t mask = 0;
+    std::stringstream stream(categories);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t") + 1);
+        bool found = false;
+        for (size_t i = 0; i < static_cast<size_t>(Category::Count); i++) {
+            if (name == CATEGORY_NAMES[i]) {
+                mask |= 1u << i;
+                found = true;
+            }
+        }
+        if (!found && !name.empty()) {
+            std::cerr << "Unknown log category '" << name << "'" << std::endl;
+        }
+    }
+    setCategories(mask);
+}
+
+const char* levelName(Level level) {
+    return LEVEL_NAMES[static_cast<size_t>(level)];
+}
+
+const char* categoryName(Category category) {
+    return CATEGORY_NAMES[static_cast<size_t>(category)];
+}
+
+void start(const std::string& logFile) {
+    State& logState = state();
+    if (logState.running.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (!logFile.empty()) {
+        std::lock_guard<std::mutex> lock(logState.outputMutex);
+        logState.jsonFile.open(logFile, std::ios::trunc);
+        if (!logState.jsonFile.is_open()) {
+            std::cerr << "Failed to open log file: " << logFile << std::endl;
+        }
+    }
+
+    logState.startTicks = readProfileTicks();
+    logState.startNs = SDL_GetTicksNS();
+    logState.running.store(true, std::memory_order_release);
+    logState.writer = Threading::createThread(Threading::configForRole(Threading::ThreadRole::Worker, "log writer"), writerMain);
+    if (!logState.atExitRegistered) {
+        std::atexit(stop);
+        logState.atExitRegistered = true;
+    }
+}
+
+void stop() {
+    State& logState = state();
+    if (!logState.running.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(logState.wakeMutex);
+        logState.running.store(false, std::memory_order_release);
+    }
+    logState.wakeCondition.notify_all();
+    if (logState.writer.joinable()) {
+        logState.writer.join();
+    }
+
+    std::lock_guard<std::mutex> lock(logState.outputMutex);
+    if (logState.jsonFile.is_open()) {
+        logState.jsonFile.close();
+    }
+}
+
+uint64_t getDroppedCount() {
+    State& logState = state();
+    std::lock_guard<std::mutex> lock(logState.registryMutex);
+    uint64_t dropped = 0;
+    for (auto& ring : logState.rings) {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+} // namespace Log
@@ -1,15 +1,68 @@
 #include <app/app.hpp>
 #include <settings/settings.hpp>
+#include <profiling/profiler.hpp>
+#include <logging/logger.hpp>
+#include <config/resource_paths.hpp>
 #include <iostream>
 #include <audio/audio.hpp>
+#include <cstring>
 
 int main(int argc, char* argv[]) {
 
+    // Load settings (window size, frame limits, thread scheduling); defaults are used if missing
+    g_settings.loadFromFile(Config::GRAPHICS_CONFIG_FILE);
+    
+    // Engine log records are written by a background thread from here on
+    Log::configure(g_settings.logLevel, g_settings.logCategories);
+    Log::start(g_settings.logFile);
+
     try {
+        // Input recording/replay options:
+        //   --record-input <file>
+        //   --replay-input <file> [--replay-mode frame|realtime] [--exit-after-replay]
+        // Headless and benchmark runs:
+        //   --headless             no window or renderer
+        //   --frames <n>           exit after n frames with a timing summary
+        //   --max-fps <n>          override maxFPS (0 = uncapped)
+        // Debugging:
+        //   --export-frame-graph <file.dot>
+        //   --profile-capture <n>  profile the first n frames (Chrome trace)
+        std::string recordPath, replayPath, frameGraphPath;
+        ReplayMode replayMode = ReplayMode::FrameLocked;
+        bool exitAfterReplay = false;
+        bool headless = false;
+        uint64_t frameLimit = 0;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--record-input") == 0 && i + 1 < argc) {
+                recordPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--replay-input") == 0 && i + 1 < argc) {
+                replayPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--replay-mode") == 0 && i + 1 < argc) {
+                if (!InputReplayer::parseReplayMode(argv[++i], replayMode)) {
+                    std::cerr << "Unknown replay mode: " << argv[i] << " (expected frame or realtime)" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            } else if (std::strcmp(argv[i], "--exit-after-replay") == 0) {
+                exitAfterReplay = true;
+            } else if (std::strcmp(argv[i], "--headless") == 0) {
+                headless = true;
+            } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+                frameLimit = std::stoull(argv[++i]);
+            } else if (std::strcmp(argv[i], "--max-fps") == 0 && i + 1 < argc) {
+                g_settings.maxFPS = std::stoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--export-frame-graph") == 0 && i + 1 < argc) {
+                frameGraphPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--profile-capture") == 0 && i + 1 < argc) {
+                gProfiler.requestCapture(static_cast<uint32_t>(std::stoul(argv[++i])));
+            }
+        }
+        
         // Create application with settings from global config
         App app("Vulkan SDL Game Engine", 
                        g_settings.screenWidth, 
                        g_settings.screenHeight);
+        app.setHeadless(headless);
+        app.setFrameLimit(frameLimit);
         
         // Initialize the application
         if (!app.initialize()) {
@@ -17,6 +70,17 @@ int main(int argc, char* argv[]) {
             return EXIT_FAILURE;
         }
         
+        if (!replayPath.empty() && !app.startInputReplay(replayPath, replayMode, exitAfterReplay)) {
+            return EXIT_FAILURE;
+        }
+        if (!recordPath.empty() && !app.startInputRecording(recordPath)) {
+            return EXIT_FAILURE;
+        }
+        
+        if (!frameGraphPath.empty()) {
+            app.exportFrameGraph(frameGraphPath);
+        }
+        
         // Run the main loop
         app.run();
         
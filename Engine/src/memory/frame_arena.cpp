@@ -0,0 +1,159 @@
+#include <memory/frame_arena.hpp>
+#include <memory/memory_tracker.hpp>
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+namespace Memory {
+
+FrameArena gFrameArena;
+
+namespace {
+    thread_local ScratchStack threadScratch;
+
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    void* allocateBlock(size_t bytes) {
+        return ::operator new(std::max<size_t>(bytes, 1), std::align_val_t(MAX_ARENA_ALIGNMENT));
+    }
+
+    void freeBlock(void* block) {
+        ::operator delete(block, std::align_val_t(MAX_ARENA_ALIGNMENT));
+    }
+}
+
+FrameArena::~FrameArena() {
+    for (Buffer& buffer : buffers) {
+        releaseOverflow(buffer);
+        if (buffer.memory) {
+            freeBlock(buffer.memory);
+        }
+    }
+}
+
+void FrameArena::initialize(size_t bytesPerBuffer) {
+    MEMORY_TAG_SCOPE(Tag::General);
+    capacity = alignUp(bytesPerBuffer, MAX_ARENA_ALIGNMENT);
+    for (Buffer& buffer : buffers) {
+        releaseOverflow(buffer);
+        if (buffer.memory) {
+            freeBlock(buffer.memory);
+        }
+        buffer.memory = capacity > 0 ? static_cast<unsigned char*>(allocateBlock(capacity)) : nullptr;
+        buffer.offset.store(0, std::memory_order_relaxed);
+        buffer.overflowBlocks.reserve(16);
+    }
+    current.store(&buffers[0], std::memory_order_release);
+}
+
+void FrameArena::beginFrame(uint64_t frameIndex) {
+    Buffer& buffer = buffers[frameIndex % BUFFER_COUNT];
+
+    size_t used = buffer.offset.load(std::memory_order_relaxed) + buffer.overflowBytes.load(std::memory_order_relaxed);
+    if (used > peakBytes.load(std::memory_order_relaxed)) {
+        peakBytes.store(used, std::memory_order_relaxed);
+    }
+    if (!buffer.overflowBlocks.empty() && !overflowReported) {
+        std::cerr << "Frame arena overflowed: a frame used " << used / 1024 << " KB of "
+                  << capacity / 1024 << " KB; raise frameArenaKB" << std::endl;
+        overflowReported = true;
+    }
+
+    releaseOverflow(buffer);
+    buffer.offset.store(0, std::memory_order_relaxed);
+    current.store(&buffer, std::memory_order_release);
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    Buffer& buffer = *current.load(std::memory_order_acquire);
+    if (alignment > MAX_ARENA_ALIGNMENT || !buffer.memory) {
+        return allocateOverflow(buffer, bytes, alignment);
+    }
+
+    size_t offset = buffer.offset.load(std::memory_order_relaxed);
+    for (;;) {
+        size_t start = alignUp(offset, alignment);
+        if (start + bytes > capacity) {
+            return allocateOverflow(buffer, bytes, alignment);
+        }
+        if (buffer.offset.compare_exchange_weak(offset, start + bytes, std::memory_order_relaxed)) {
+            return buffer.memory + start;
+        }
+    }
+}
+
+void* FrameArena::allocateOverflow(Buffer& buffer, size_t bytes, size_t alignment) {
+    if (alignment > MAX_ARENA_ALIGNMENT) {
+        throw std::bad_alloc();
+    }
+    void* block = allocateBlock(bytes);
+    std::lock_guard<std::mutex> lock(buffer.overflowMutex);
+    buffer.overflowBlocks.push_back(block);
+    buffer.overflowBytes.fetch_add(bytes, std::memory_order_relaxed);
+    overflowCount.fetch_add(1, std::memory_order_relaxed);
+    return block;
+}
+
+void FrameArena::releaseOverflow(Buffer& buffer) {
+    std::lock_guard<std::mutex> lock(buffer.overflowMutex);
+    for (void* block : buffer.overflowBlocks) {
+        freeBlock(block);
+    }
+    buffer.overflowBlocks.clear();
+    buffer.overflowBytes.store(0, std::memory_order_relaxed);
+}
+
+ScratchStack::~ScratchStack() {
+    if (base) {
+        freeBlock(base);
+    }
+}
+
+bool ScratchStack::owns(const void* pointer) const {
+    const unsigned char* bytes = static_cast<const unsigned char*>(pointer);
+    return base && bytes >= base && bytes < base + capacity;
+}
+
+void* ScratchStack::allocate(size_t bytes, size_t alignment) {
+    if (alignment > MAX_ARENA_ALIGNMENT) {
+        throw std::bad_alloc();
+    }
+    if (openScopes > 0) {
+        if (!base) {
+            MEMORY_TAG_SCOPE(Tag::General);
+            capacity = DEFAULT_CAPACITY;
+            base = static_cast<unsigned char*>(allocateBlock(capacity));
+        }
+        size_t start = alignUp(top, alignment);
+        if (start + bytes <= capacity) {
+            top = start + bytes;
+            peak = std::max(peak, top);
+            return base + start;
+        }
+    }
+    // No scope to rewind, or full: a heap block freed by deallocate()
+    return allocateBlock(bytes);
+}
+
+void ScratchStack::deallocate(void* pointer) {
+    if (pointer && !owns(pointer)) {
+        freeBlock(pointer);
+    }
+}
+
+ScratchStack& scratch() {
+    return threadScratch;
+}
+
+ScratchScope::ScratchScope() : stack(threadScratch), marker(threadScratch.top) {
+    stack.openScopes++;
+}
+
+ScratchScope::~ScratchScope() {
+    stack.top = marker;
+    stack.openScopes--;
+}
+
+} // namespace Memory
@@ -0,0 +1,278 @@
+#include <memory/memory_tracker.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+namespace Memory {
+
+namespace {
+    constexpr size_t TAG_COUNT = static_cast<size_t>(Tag::Count);
+
+    // Constant-initialised, so allocations made before main are counted too
+    struct alignas(64) Counters {
+        std::atomic<uint64_t> liveBytes{0};
+        std::atomic<uint64_t> peakBytes{0};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytesAllocated{0};
+    };
+    Counters counters[TAG_COUNT];
+    std::atomic<uint64_t> budgets[TAG_COUNT];
+    std::atomic<bool> reportRequested{false};
+
+    thread_local Tag threadTag = Tag::General;
+
+    // Main thread only (onFrameEnd)
+    struct FrameRate {
+        uint64_t lastAllocations = 0;
+        uint64_t firstAllocations = 0;
+        uint64_t maxPerFrame = 0;
+        bool overBudget = false;
+    };
+    std::array<FrameRate, TAG_COUNT> frameRates;
+    uint64_t framesObserved = 0;
+
+    double megabytes(uint64_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+}
+
+TagScope::TagScope(Tag tag) : previous(threadTag) {
+    threadTag = tag;
+}
+
+TagScope::~TagScope() {
+    threadTag = previous;
+}
+
+Tag currentTag() {
+    return threadTag;
+}
+
+TagStats getTagStats(Tag tag) {
+    size_t index = static_cast<size_t>(tag);
+    const Counters& counter = counters[index];
+    TagStats stats;
+    stats.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+    stats.allocations = counter.allocations.load(std::memory_order_relaxed);
+    stats.bytesAllocated = counter.bytesAllocated.load(std::memory_order_relaxed);
+    stats.budgetBytes = budgets[index].load(std::memory_order_relaxed);
+    if (framesObserved > 0) {
+        stats.allocationsPerFrame = static_cast<double>(frameRates[index].lastAllocations - frameRates[index].firstAllocations) /
+                                    static_cast<double>(framesObserved);
+    }
+    stats.maxAllocationsPerFrame = frameRates[index].maxPerFrame;
+    return stats;
+}
+
+const char* tagName(Tag tag) {
+    switch (tag) {
+        case Tag::General:  return "general";
+        case Tag::Audio:    return "audio";
+        case Tag::Input:    return "input";
+        case Tag::Renderer: return "renderer";
+        case Tag::Assets:   return "assets";
+        case Tag::Count:    break;
+    }
+    return "unknown";
+}
+
+void setBudget(Tag tag, uint64_t bytes) {
+    budgets[static_cast<size_t>(tag)].store(bytes, std::memory_order_relaxed);
+}
+
+void parseBudgets(const std::string& spec) {
+    std::stringstream stream(spec);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+        size_t colon = entry.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = entry.substr(0, colon);
+        name.erase(std::remove(name.begin(), name.end(), ' '), name.end());
+
+        bool found = false;
+        for (size_t tag = 0; tag < TAG_COUNT; tag++) {
+            if (name == tagName(static_cast<Tag>(tag))) {
+                setBudget(static_cast<Tag>(tag), std::stoull(entry.substr(colon + 1)) * 1024 * 1024);
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            std::cerr << "Unknown memory budget tag: " << name << std::endl;
+        }
+    }
+}
+
+void onFrameEnd() {
+    if (!TRACKING_ENABLED) {
+        return;
+    }
+
+    for (size_t tag = 0; tag < TAG_COUNT; tag++) {
+        FrameRate& rate = frameRates[tag];
+        uint64_t allocations = counters[tag].allocations.load(std::memory_order_relaxed);
+        if (framesObserved == 0) {
+            rate.firstAllocations = allocations;
+        } else {
+            rate.maxPerFrame = std::max(rate.maxPerFrame, allocations - rate.lastAllocations);
+        }
+        rate.lastAllocations = allocations;
+
+        // Warn when crossing the budget, and again only after dropping below 90% of it
+        uint64_t budget = budgets[tag].load(std::memory_order_relaxed);
+        uint64_t live = counters[tag].liveBytes.load(std::memory_order_relaxed);
+        if (budget > 0 && !rate.overBudget && live > budget) {
+            rate.overBudget = true;
+            std::cerr << std::fixed << std::setprecision(1)
+                      << "Memory budget exceeded: " << tagName(static_cast<Tag>(tag)) << " uses "
+                      << megabytes(live) << " MB of " << megabytes(budget) << " MB" << std::endl;
+            std::cerr.unsetf(std::ios::floatfield);
+        } else if (rate.overBudget && live < budget / 10 * 9) {
+            rate.overBudget = false;
+        }
+    }
+    framesObserved++;
+
+    if (reportRequested.exchange(false, std::memory_order_relaxed)) {
+        report(std::cout);
+    }
+}
+
+void requestReport() {
+    reportRequested.store(true, std::memory_order_relaxed);
+}
+
+void report(std::ostream& out) {
+    if (!TRACKING_ENABLED) {
+        out << "Memory tracking is compiled out of production builds\n";
+        return;
+    }
+
+    out << "Memory by tag (MB)\n";
+    out << std::left << std::setw(10) << "tag" << std::right
+        << std::setw(10) << "live" << std::setw(10) << "peak" << std::setw(10) << "budget"
+        << std::setw(12) << "allocs" << std::setw(13) << "allocs/frame" << std::setw(10) << "max/frame" << "\n";
+    out << std::fixed;
+    for (size_t tag = 0; tag < TAG_COUNT; tag++) {
+        TagStats stats = getTagStats(static_cast<Tag>(tag));
+        out << std::left << std::setw(10) << tagName(static_cast<Tag>(tag)) << std::right << std::setprecision(2)
+            << std::setw(10) << megabytes(stats.liveBytes)
+            << std::setw(10) << megabytes(stats.peakBytes);
+        if (stats.budgetBytes > 0) {
+            out << std::setw(10) << megabytes(stats.budgetBytes);
+        } else {
+            out << std::setw(10) << "-";
+        }
+        out << std::setw(12) << stats.allocations << std::setprecision(1)
+            << std::setw(13) << stats.allocationsPerFrame
+            << std::setw(10) << stats.maxAllocationsPerFrame
+            << (stats.budgetBytes > 0 && stats.peakBytes > stats.budgetBytes ? "  over budget" : "") << "\n";
+    }
+    out.unsetf(std::ios::floatfield);
+}
+
+} // namespace Memory
+
+#if !PRODUCTION_BUILD
+
+// Every allocation carries a header just below the pointer handed out: its
+// size and tag, and how far the block starts before it (for aligned blocks)
+namespace {
+    struct AllocationHeader {
+        uint64_t size;
+        uint32_t tag;
+        uint32_t offset;
+    };
+    constexpr size_t HEADER_SIZE = 16;
+    static_assert(sizeof(AllocationHeader) <= HEADER_SIZE, "Allocation header must fit its slot");
+    static_assert(alignof(std::max_align_t) <= HEADER_SIZE, "Header slot must keep default alignment");
+
+    void* trackedAllocate(size_t size, size_t alignment) noexcept {
+        size_t slack = alignment > HEADER_SIZE ? alignment - 1 : 0;
+        if (size > SIZE_MAX - HEADER_SIZE - slack) {
+            return nullptr; // the padded size would wrap; operator new throws bad_alloc
+        }
+        unsigned char* base = static_cast<unsigned char*>(std::malloc(size + HEADER_SIZE + slack));
+        if (!base) {
+            return nullptr;
+        }
+
+        uintptr_t user = reinterpret_cast<uintptr_t>(base) + HEADER_SIZE;
+        if (alignment > HEADER_SIZE) {
+            user = (user + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        }
+        unsigned char* pointer = reinterpret_cast<unsigned char*>(user);
+
+        size_t tag = static_cast<size_t>(Memory::currentTag());
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(pointer - HEADER_SIZE);
+        header->size = size;
+        header->tag = static_cast<uint32_t>(tag);
+        header->offset = static_cast<uint32_t>(pointer - base);
+
+        Memory::Counters& counter = Memory::counters[tag];
+        uint64_t live = counter.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        counter.allocations.fetch_add(1, std::memory_order_relaxed);
+        counter.bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+        uint64_t peak = counter.peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counter.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+        return pointer;
+    }
+
+    void trackedFree(void* pointer) noexcept {
+        if (!pointer) {
+            return;
+        }
+        unsigned char* user = static_cast<unsigned char*>(pointer);
+        const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(user - HEADER_SIZE);
+        Memory::counters[header->tag].liveBytes.fetch_sub(header->size, std::memory_order_relaxed);
+        std::free(user - header->offset);
+    }
+
+    void* allocateOrThrow(size_t size, size_t alignment) {
+        void* pointer = trackedAllocate(size, alignment);
+        while (!pointer) {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+            pointer = trackedAllocate(size, alignment);
+        }
+        return pointer;
+    }
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return trackedAllocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return trackedAllocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+
+#endif
@@ -0,0 +1,183 @@
+#include <profiling/frame_stats.hpp>
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+FrameStats gFrameStats;
+
+void FrameStats::beginFrame(uint64_t frameIndex) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    uint64_t now = SDL_GetTicksNS();
+    if (firstFrame == UINT64_MAX) {
+        firstFrame = frameIndex;
+        nextRetire = frameIndex;
+    } else {
+        addTime(lastFrame, FramePhase::Frame, now - frameStartNs);
+    }
+    frameStartNs = now;
+    lastFrame = frameIndex;
+
+    // The slot last held frameIndex - RING_FRAMES, retired long ago
+    FrameRow& row = rows[frameIndex & (RING_FRAMES - 1)];
+    for (auto& value : row.ns) {
+        value.store(0, std::memory_order_relaxed);
+    }
+    row.timedPhases.store(0, std::memory_order_relaxed);
+    row.frameIndex.store(frameIndex, std::memory_order_release);
+}
+
+void FrameStats::endFrame(uint64_t frameIndex) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    while (nextRetire + RETIRE_LAG <= frameIndex) {
+        retire(nextRetire++);
+    }
+
+    if (dumpRequested.exchange(false, std::memory_order_relaxed)) {
+        std::string path = "frame_stats_" + std::to_string(++dumpCount) + ".csv";
+        if (writeCsv(path)) {
+            std::cout << "Frame statistics written to " << path << std::endl;
+        }
+    }
+}
+
+void FrameStats::addTime(uint64_t frameIndex, FramePhase phase, uint64_t ns) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    FrameRow& row = rows[frameIndex & (RING_FRAMES - 1)];
+    if (row.frameIndex.load(std::memory_order_acquire) != frameIndex) {
+        return; // frame not begun yet, or already overwritten
+    }
+    row.ns[static_cast<size_t>(phase)].fetch_add(ns, std::memory_order_relaxed);
+    row.timedPhases.fetch_or(1u << static_cast<uint32_t>(phase), std::memory_order_release);
+}
+
+void FrameStats::onPresent(uint64_t frameIndex) {
+    uint64_t now = SDL_GetTicksNS();
+    if (lastPresentNs != 0) {
+        addTime(frameIndex, FramePhase::PresentInterval, now - lastPresentNs);
+    }
+    lastPresentNs = now;
+}
+
+void FrameStats::flush() {
+    if (firstFrame == UINT64_MAX) {
+        return;
+    }
+    // The last frame has no frame time, it never reached the next frame's start
+    while (nextRetire <= lastFrame) {
+        retire(nextRetire++);
+    }
+}
+
+void FrameStats::retire(uint64_t frameIndex) {
+    const FrameRow& row = rows[frameIndex & (RING_FRAMES - 1)];
+    if (row.frameIndex.load(std::memory_order_acquire) != frameIndex) {
+        return;
+    }
+
+    uint32_t timed = row.timedPhases.load(std::memory_order_acquire);
+    for (size_t phase = 0; phase < histograms.size(); phase++) {
+        if (timed & (1u << phase)) {
+            histograms[phase].record(row.ns[phase].load(std::memory_order_relaxed));
+        }
+    }
+}
+
+const char* FrameStats::phaseName(FramePhase phase) {
+    switch (phase) {
+        case FramePhase::ProcessEvents:   return "processEvents";
+        case FramePhase::Update:          return "update";
+        case FramePhase::Audio:           return "audio";
+        case FramePhase::Render:          return "render";
+        case FramePhase::Gpu:             return "gpu";
+        case FramePhase::Frame:           return "frame";
+        case FramePhase::PresentInterval: return "presentInterval";
+        case FramePhase::Count:           break;
+    }
+    return "unknown";
+}
+
+void FrameStats::report(std::ostream& out) const {
+    auto ms = [](uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+
+    out << "Frame statistics (ms)\n";
+    out << std::left << std::setw(17) << "phase" << std::right
+        << std::setw(8) << "frames" << std::setw(9) << "mean" << std::setw(9) << "p50"
+        << std::setw(9) << "p95" << std::setw(9) << "p99" << std::setw(9) << "max" << "\n";
+    out << std::fixed << std::setprecision(3);
+    for (size_t phase = 0; phase < histograms.size(); phase++) {
+        const LatencyHistogram& histogram = histograms[phase];
+        if (histogram.getCount() == 0) {
+            continue;
+        }
+        out << std::left << std::setw(17) << phaseName(static_cast<FramePhase>(phase)) << std::right
+            << std::setw(8) << histogram.getCount()
+            << std::setw(9) << ms(histogram.getMeanNs())
+            << std::setw(9) << ms(histogram.getPercentileNs(0.50))
+            << std::setw(9) << ms(histogram.getPercentileNs(0.95))
+            << std::setw(9) << ms(histogram.getPercentileNs(0.99))
+            << std::setw(9) << ms(histogram.getMaxNs()) << "\n";
+    }
+
+    // Stutter: frames that took over twice the median frame time
+    const LatencyHistogram& frames = histograms[static_cast<size_t>(FramePhase::Frame)];
+    if (frames.getCount() > 0) {
+        uint64_t threshold = 2 * frames.getPercentileNs(0.50);
+        uint64_t stutters = 0;
+        for (size_t bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+            if (LatencyHistogram::bucketLowerUs(bucket) * 1000 >= threshold) {
+                stutters += frames.getBucketCount(bucket);
+            }
+        }
+        out << "Frames over " << ms(threshold) << " ms (2x median): " << stutters << "\n";
+    }
+    out.unsetf(std::ios::floatfield);
+}
+
+bool FrameStats::writeCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open frame statistics file: " << path << std::endl;
+        return false;
+    }
+
+    file << "frame";
+    for (size_t phase = 0; phase < histograms.size(); phase++) {
+        file << "," << phaseName(static_cast<FramePhase>(phase)) << "_ms";
+    }
+    file << "\n";
+
+    if (firstFrame == UINT64_MAX) {
+        return true;
+    }
+
+    file << std::fixed << std::setprecision(4);
+    uint64_t first = std::max(firstFrame, lastFrame >= RING_FRAMES ? lastFrame - RING_FRAMES + 1 : 0);
+    for (uint64_t frameIndex = first; frameIndex <= lastFrame; frameIndex++) {
+        const FrameRow& row = rows[frameIndex & (RING_FRAMES - 1)];
+        if (row.frameIndex.load(std::memory_order_acquire) != frameIndex) {
+            continue;
+        }
+        uint32_t timed = row.timedPhases.load(std::memory_order_acquire);
+        file << frameIndex;
+        for (size_t phase = 0; phase < histograms.size(); phase++) {
+            file << ",";
+            if (timed & (1u << phase)) {
+                file << static_cast<double>(row.ns[phase].load(std::memory_order_relaxed)) / 1e6;
+            }
+        }
+        file << "\n";
+    }
+    return true;
+}
@@ -0,0 +1,265 @@
+#include <profiling/latency_tracer.hpp>
+#include <memory/frame_arena.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <string>
+
+LatencyTracer gLatencyTracer;
+
+namespace {
+    thread_local uint32_t currentSound = 0;
+
+    int highestBit(uint64_t value) {
+        int bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+    }
+
+    double toMs(uint64_t ns) {
+        return static_cast<double>(ns) / 1e6;
+    }
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t latencyUs) {
+    if (latencyUs < SUB_BUCKETS) {
+        return static_cast<size_t>(latencyUs);
+    }
+    int octave = highestBit(latencyUs);
+    size_t bucket = (octave - 2) * SUB_BUCKETS + ((latencyUs >> (octave - 3)) & (SUB_BUCKETS - 1));
+    return std::min(bucket, BUCKET_COUNT - 1);
+}
+
+uint64_t LatencyHistogram::bucketLowerUs(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    size_t octave = bucket / SUB_BUCKETS + 2;
+    return (SUB_BUCKETS + bucket % SUB_BUCKETS) << (octave - 3);
+}
+
+void LatencyHistogram::record(uint64_t latencyNs) {
+    buckets[bucketOf(latencyNs / 1000)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sumNs.fetch_add(latencyNs, std::memory_order_relaxed);
+
+    uint64_t worst = maxNs.load(std::memory_order_relaxed);
+    while (latencyNs > worst && !maxNs.compare_exchange_weak(worst, latencyNs, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sumNs.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMeanNs() const {
+    uint64_t samples = getCount();
+    return samples ? sumNs.load(std::memory_order_relaxed) / samples : 0;
+}
+
+uint64_t LatencyHistogram::getPercentileNs(double fraction) const {
+    uint64_t samples = getCount();
+    if (samples == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(samples) + 0.5);
+    target = std::max<uint64_t>(target, 1);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        seen += getBucketCount(bucket);
+        if (seen >= target) {
+            if (bucket + 1 == BUCKET_COUNT) {
+                break;
+            }
+            return std::min(bucketLowerUs(bucket + 1) * 1000, getMaxNs());
+        }
+    }
+    return getMaxNs();
+}
+
+bool LatencyTracer::isTracedEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+            return !event.key.repeat; // auto-repeat is not a user action
+        case SDL_EVENT_MOUSE_MOTION:
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void LatencyTracer::onFrameEvent(const SDL_Event& event) {
+    if (!isEnabled() || event.common.timestamp == 0 || !isTracedEvent(event)) {
+        return;
+    }
+
+    uint64_t now = SDL_GetTicksNS();
+    if (now >= event.common.timestamp) {
+        histograms[static_cast<size_t>(LatencyStage::Dispatch)].record(now - event.common.timestamp);
+    }
+
+    if (frameEventCount < MAX_FRAME_EVENTS) {
+        frameTimestamps[frameEventCount++] = event.common.timestamp;
+    } else {
+        droppedEvents++;
+    }
+}
+
+void LatencyTracer::onFrameStage(LatencyStage stage) {
+    onFrameStage(stage, FrameEvents{frameTimestamps.data(), frameEventCount});
+}
+
+void LatencyTracer::onFrameStage(LatencyStage stage, const FrameEvents& events) {
+    if (!isEnabled() || events.count == 0) {
+        return;
+    }
+
+    uint64_t now = SDL_GetTicksNS();
+    LatencyHistogram& histogram = histograms[static_cast<size_t>(stage)];
+    for (size_t i = 0; i < events.count; i++) {
+        if (now >= events.timestamps[i]) {
+            histogram.record(now - events.timestamps[i]);
+        }
+    }
+}
+
+void LatencyTracer::takeFrameEvents(FrameEvents& events) {
+    events = FrameEvents{};
+    if (frameEventCount > 0) {
+        uint64_t* timestamps = static_cast<uint64_t*>(Memory::gFrameArena.allocate(frameEventCount * sizeof(uint64_t), alignof(uint64_t)));
+        std::copy(frameTimestamps.begin(), frameTimestamps.begin() + frameEventCount, timestamps);
+        events.timestamps = timestamps;
+        events.count = frameEventCount;
+    }
+    frameEventCount = 0;
+}
+
+uint32_t LatencyTracer::beginSound(uint64_t inputTimestampNs) {
+    if (!isEnabled() || inputTimestampNs == 0) {
+        return 0;
+    }
+
+    uint32_t id = nextSoundTrace.fetch_add(1, std::memory_order_relaxed);
+    if (id == 0) {
+        id = nextSoundTrace.fetch_add(1, std::memory_order_relaxed); // skip the untraced id on wrap
+    }
+
+    // The oldest trace in the slot is simply replaced
+    SoundTrace& trace = soundTraces[id & (MAX_SOUND_TRACES - 1)];
+    trace.inputNs.store(inputTimestampNs, std::memory_order_relaxed);
+    trace.id.store(id, std::memory_order_release);
+    return id;
+}
+
+void LatencyTracer::onSoundStage(uint32_t traceId, LatencyStage stage, uint64_t timeNs) {
+    if (traceId == 0 || !isEnabled()) {
+        return;
+    }
+
+    const SoundTrace& trace = soundTraces[traceId & (MAX_SOUND_TRACES - 1)];
+    if (trace.id.load(std::memory_order_acquire) != traceId) {
+        return; // overwritten by a newer note
+    }
+
+    uint64_t inputNs = trace.inputNs.load(std::memory_order_relaxed);
+    uint64_t stageNs = timeNs ? timeNs : SDL_GetTicksNS();
+    if (stageNs >= inputNs) {
+        histograms[static_cast<size_t>(stage)].record(stageNs - inputNs);
+    }
+}
+
+LatencyTracer::SoundScope::SoundScope(const SDL_Event& event) : previous(currentSound) {
+    currentSound = gLatencyTracer.beginSound(event.common.timestamp);
+}
+
+LatencyTracer::SoundScope::~SoundScope() {
+    currentSound = previous;
+}
+
+uint32_t LatencyTracer::currentSoundTrace() {
+    return currentSound;
+}
+
+const char* LatencyTracer::stageName(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::Dispatch:    return "input -> dispatch";
+        case LatencyStage::Update:      return "input -> update";
+        case LatencyStage::Submit:      return "input -> submit";
+        case LatencyStage::Present:     return "input -> present";
+        case LatencyStage::PlayNote:    return "input -> playNote";
+        case LatencyStage::NoteOn:      return "input -> note on";
+        case LatencyStage::FirstSample: return "input -> first sample";
+        default:                        return "unknown";
+    }
+}
+
+void LatencyTracer::report(std::ostream& out) const {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2);
+    out << "Input latency (ms)          count     mean      p50      p90      p99      max\n";
+    for (size_t i = 0; i < histograms.size(); i++) {
+        const LatencyHistogram& histogram = histograms[i];
+        out << "  " << std::left << std::setw(24) << stageName(static_cast<LatencyStage>(i)) << std::right
+            << std::setw(7) << histogram.getCount()
+            << std::setw(9) << toMs(histogram.getMeanNs())
+            << std::setw(9) << toMs(histogram.getPercentileNs(0.50))
+            << std::setw(9) << toMs(histogram.getPercentileNs(0.90))
+            << std::setw(9) << toMs(histogram.getPercentileNs(0.99))
+            << std::setw(9) << toMs(histogram.getMaxNs()) << "\n";
+    }
+    if (droppedEvents > 0) {
+        out << "  (" << droppedEvents << " events over the per-frame limit were not traced)\n";
+    }
+    out.flags(flags);
+
+    writeHistogram(out, LatencyStage::Present);
+    writeHistogram(out, LatencyStage::FirstSample);
+}
+
+void LatencyTracer::writeHistogram(std::ostream& out, LatencyStage stage) const {
+    const LatencyHistogram& histogram = getHistogram(stage);
+    if (histogram.getCount() == 0) {
+        return;
+    }
+
+    uint64_t largest = 0;
+    for (size_t bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+        largest = std::max(largest, histogram.getBucketCount(bucket));
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << stageName(stage) << " histogram (ms):\n";
+    for (size_t bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+        uint64_t samples = histogram.getBucketCount(bucket);
+        if (samples == 0) {
+            continue;
+        }
+        constexpr size_t BAR_WIDTH = 40;
+        size_t bar = static_cast<size_t>((samples * BAR_WIDTH + largest - 1) / largest);
+        out << "  " << std::setw(9) << LatencyHistogram::bucketLowerUs(bucket) / 1000.0 << " "
+            << std::setw(7) << samples << " " << std::string(bar, '#') << "\n";
+    }
+    out.flags(flags);
+}
+
+void LatencyTracer::reset() {
+    for (auto& histogram : histograms) {
+        histogram.reset();
+    }
+    frameEventCount = 0;
+    droppedEvents = 0;
+}
@@ -0,0 +1,150 @@
+#include <profiling/profiler.hpp>
+#include <threading/threading.hpp>
+#include <profilerLib.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+FrameProfiler gProfiler;
+
+namespace {
+    struct ExportedEvent {
+        const char* name;
+        uint64_t startTicks;
+        uint64_t endTicks;
+    };
+
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; c++) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\';
+            }
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+FrameProfiler::ThreadBuffer* FrameProfiler::registerThread() {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->events.reset(new Event[EVENTS_PER_THREAD]);
+    buffer->threadName = Threading::currentThreadName();
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffer->threadId = static_cast<uint32_t>(buffers.size() + 1);
+    if (buffer->threadName.empty()) {
+        buffer->threadName = "thread " + std::to_string(buffer->threadId);
+    }
+    buffers.push_back(std::move(buffer));
+    return buffers.back().get();
+}
+
+void FrameProfiler::onFrameBoundary() {
+    uint64_t now = readProfileTicks();
+
+    if (isCapturing()) {
+        record("frame", frameStartTicks, now);
+        if (--framesLeft == 0) {
+            endCapture(now);
+        }
+    } else if (uint32_t frames = requestedFrames.exchange(0, std::memory_order_relaxed)) {
+        beginCapture(frames, now);
+    }
+
+    frameStartTicks = now;
+}
+
+void FrameProfiler::stopCapture() {
+    if (isCapturing()) {
+        endCapture(readProfileTicks());
+    }
+}
+
+void FrameProfiler::beginCapture(uint32_t frames, uint64_t nowTicks) {
+    framesLeft = frames;
+    captureStartTicks = nowTicks;
+    captureStartNs = SDL_GetTicksNS();
+    capturing.store(true, std::memory_order_relaxed);
+    std::cout << "Profiler: capturing " << frames << " frames" << std::endl;
+}
+
+void FrameProfiler::endCapture(uint64_t nowTicks) {
+    capturing.store(false, std::memory_order_relaxed);
+    captureEndTicks = nowTicks;
+    captureEndNs = SDL_GetTicksNS();
+
+    std::string path = "profile_capture_" + std::to_string(++captureCount) + ".json";
+    writeChromeTrace(path);
+}
+
+bool FrameProfiler::writeChromeTrace(const std::string& path) {
+    PL::Profiler exportTimer;
+    exportTimer.start();
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Profiler: failed to open " << path << std::endl;
+        return false;
+    }
+
+    // Ticks to nanoseconds, calibrated over the capture
+    uint64_t spanTicks = std::max<uint64_t>(captureEndTicks - captureStartTicks, 1);
+    double nsPerTick = static_cast<double>(captureEndNs - captureStartNs) / static_cast<double>(spanTicks);
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    size_t eventCount = 0;
+    bool first = true;
+    std::vector<ExportedEvent> events;
+    for (const auto& buffer : buffers) {
+        // Copy the ring, then drop whatever the owner may have overwritten meanwhile
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+        events.clear();
+        for (uint64_t index = begin; index < head; index++) {
+            const Event& event = buffer->events[index & (EVENTS_PER_THREAD - 1)];
+            events.push_back({event.name.load(std::memory_order_relaxed),
+                              event.startTicks.load(std::memory_order_relaxed),
+                              event.endTicks.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t headAfter = buffer->head.load(std::memory_order_relaxed);
+        size_t overwritten = headAfter >= begin + EVENTS_PER_THREAD ? static_cast<size_t>(headAfter - begin - EVENTS_PER_THREAD + 1) : 0;
+        events.erase(events.begin(), events.begin() + std::min(overwritten, events.size()));
+
+        std::sort(events.begin(), events.end(), [](const ExportedEvent& a, const ExportedEvent& b) {
+            return a.startTicks < b.startTicks;
+        });
+
+        file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+             << ",\"args\":{\"name\":";
+        writeJsonString(file, buffer->threadName.c_str());
+        file << "}}";
+        first = false;
+
+        for (const ExportedEvent& event : events) {
+            // Older captures are still in the ring
+            if (event.startTicks < captureStartTicks || event.startTicks > captureEndTicks) {
+                continue;
+            }
+            double startUs = static_cast<double>(event.startTicks - captureStartTicks) * nsPerTick / 1000.0;
+            double durationUs = static_cast<double>(event.endTicks - event.startTicks) * nsPerTick / 1000.0;
+            file << ",\n{\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"ts\":" << startUs << ",\"dur\":" << durationUs << "}";
+            eventCount++;
+        }
+    }
+    file << "\n]}\n";
+    file.close();
+
+    PL::ProfileRezults exportTime = exportTimer.end();
+    std::cout << "Profiler: wrote " << eventCount << " events to " << path
+              << " in " << exportTime.timeSeconds * 1000.0f << " ms" << std::endl;
+    return true;
+}
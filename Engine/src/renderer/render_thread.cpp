@@ -0,0 +1,103 @@
+#include <renderer/render_thread.hpp>
+#include <threading/threading.hpp>
+#include <SDL3/SDL.h>
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start(DrawFunction drawFunction) {
+    if (isRunning()) {
+        return;
+    }
+    
+    draw = std::move(drawFunction);
+    writeSlot = 0;
+    pending = false;
+    stopping = false;
+    drawnFrames = 0;
+    error = nullptr;
+    
+    // Render submission is the main thread's job in serial mode, so it gets
+    // the main thread's scheduling
+    thread = Threading::createThread(Threading::configForRole(Threading::ThreadRole::Main, "render"),
+                                     [this]() { threadMain(); });
+}
+
+void RenderThread::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    thread.join();
+}
+
+void RenderThread::submit(const RenderSnapshot& snapshot) {
+    std::unique_lock<std::mutex> lock(mutex);
+    
+    // The render thread is drawing the other buffer at most, once it has
+    // picked up the previous frame
+    if (pending) {
+        uint64_t waitStart = SDL_GetTicksNS();
+        condition.wait(lock, [this]() { return !pending || error; });
+        submitWaitNs += SDL_GetTicksNS() - waitStart;
+    }
+    // The render thread is gone after a failed draw; every later call fails
+    // too instead of waiting on it forever
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    
+    snapshots[writeSlot] = snapshot;
+    pending = true;
+    writeSlot ^= 1;
+    lock.unlock();
+    condition.notify_all();
+}
+
+void RenderThread::waitUntilDrawn(uint64_t frameIndex) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (drawnFrames <= frameIndex && !error && isRunning()) {
+        uint64_t waitStart = SDL_GetTicksNS();
+        condition.wait(lock, [this, frameIndex]() { return drawnFrames > frameIndex || error; });
+        submitWaitNs += SDL_GetTicksNS() - waitStart;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void RenderThread::threadMain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        condition.wait(lock, [this]() { return pending || stopping; });
+        if (!pending) {
+            return;
+        }
+        
+        // The queued frame is the one submit() didn't just move past
+        const RenderSnapshot& snapshot = snapshots[writeSlot ^ 1];
+        uint64_t frameIndex = snapshot.frameIndex;
+        pending = false;
+        lock.unlock();
+        condition.notify_all();
+        
+        try {
+            draw(snapshot);
+        } catch (...) {
+            lock.lock();
+            error = std::current_exception();
+            condition.notify_all();
+            return;
+        }
+        
+        lock.lock();
+        drawnFrames = frameIndex + 1;
+        condition.notify_all();
+    }
+}
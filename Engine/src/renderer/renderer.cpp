@@ -7,6 +7,10 @@
 #include <vulkan/vulkan.h>
 #include <shader/shader.hpp>
 #include <renderer/renderer.hpp>
+#include <profiling/latency_tracer.hpp>
+#include <profiling/frame_stats.hpp>
+#include <memory/memory_tracker.hpp>
+#include <memory/frame_arena.hpp>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
@@ -15,6 +19,7 @@
 
 // Renderer implementation
 Renderer::Renderer(SDL_Window* window) : window(window) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Renderer);
     initVulkan();
 }
 
@@ -36,6 +41,7 @@ void Renderer::initVulkan() {
     createCommandPool();
     createCommandBuffer();
     createSyncObjects();
+    createQueryPool();
 }
 
 void Renderer::createInstance() {
@@ -62,7 +68,8 @@ void Renderer::createInstance() {
         throw std::runtime_error("Failed to get extensions!");
     }
 
-    std::vector<const char*> extensions(sdlExtensions, sdlExtensions + extensionCount);
+    Memory::ScratchScope scratchScope;
+    Memory::ScratchVector<const char*> extensions(sdlExtensions, sdlExtensions + extensionCount);
     
     createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
     createInfo.ppEnabledExtensionNames = extensions.data();
@@ -85,22 +92,29 @@ void Renderer::pickPhysicalDevice() {
         throw std::runtime_error("Failed to find GPU with Vulkan support!");
     }
     
-    std::vector<VkPhysicalDevice> devices(deviceCount);
+    Memory::ScratchScope scratchScope;
+    Memory::ScratchVector<VkPhysicalDevice> devices(deviceCount);
     vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
     physicalDevice = devices[0]; // Just use the first device
     
     // Find queue family for graphics
     uint32_t queueFamilyCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
-    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    Memory::ScratchVector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
     
     for (uint32_t i = 0; i < queueFamilyCount; i++) {
         if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
             queueFamilyIndex = i;
+            gpuTimingSupported = queueFamilies[i].timestampValidBits > 0;
             break;
         }
     }
+    
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    timestampPeriodNs = properties.limits.timestampPeriod;
+    gpuTimingSupported = gpuTimingSupported && timestampPeriodNs > 0.0f;
 }
 
 void Renderer::createLogicalDevice() {
@@ -140,7 +154,8 @@ void Renderer::createSwapChain() {
     // Simple format selection
     uint32_t formatCount;
     vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr);
-    std::vector<VkSurfaceFormatKHR> formats(formatCount);
+    Memory::ScratchScope scratchScope;
+    Memory::ScratchVector<VkSurfaceFormatKHR> formats(formatCount);
     vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, formats.data());
     surfaceFormat = formats[0]; // Just use the first format
     
@@ -156,7 +171,7 @@ void Renderer::createSwapChain() {
     swapchainInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     swapchainInfo.preTransform = capabilities.currentTransform;
     swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    swapchainInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    swapchainInfo.presentMode = choosePresentMode();
     swapchainInfo.clipped = VK_TRUE;
     
     if (vkCreateSwapchainKHR(device, &swapchainInfo, nullptr, &swapChain) != VK_SUCCESS) {
@@ -170,6 +185,29 @@ void Renderer::createSwapChain() {
     vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImages.data());
 }
 
+VkPresentModeKHR Renderer::choosePresentMode() {
+    // FIFO is always available and waits for vblank
+    if (g_settings.vsync) {
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+    
+    uint32_t modeCount;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, nullptr);
+    Memory::ScratchScope scratchScope;
+    Memory::ScratchVector<VkPresentModeKHR> modes(modeCount);
+    vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, modes.data());
+    
+    // Without vsync prefer mailbox (no tearing, newest frame wins), then immediate
+    for (VkPresentModeKHR preferred : {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR}) {
+        for (VkPresentModeKHR mode : modes) {
+            if (mode == preferred) {
+                return mode;
+            }
+        }
+    }
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
 void Renderer::createImageViews() {
     swapChainImageViews.resize(swapChainImages.size());
     for (size_t i = 0; i < swapChainImages.size(); i++) {
@@ -377,10 +415,39 @@ void Renderer::createSyncObjects() {
     }
 }
 
-void Renderer::drawFrame() {
+void Renderer::createQueryPool() {
+    if (!gpuTimingSupported) {
+        std::cout << "GPU timestamps not supported, frame statistics will have no GPU time" << std::endl;
+        return;
+    }
+    
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = 2;
+    
+    if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &timestampPool) != VK_SUCCESS) {
+        timestampPool = VK_NULL_HANDLE;
+        std::cerr << "Failed to create timestamp query pool" << std::endl;
+    }
+}
+
+void Renderer::drawFrame(const RenderSnapshot& snapshot) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Renderer);
     vkWaitForFences(device, 1, &inFlightFence, VK_TRUE, UINT64_MAX);
     vkResetFences(device, 1, &inFlightFence);
     
+    // The fence covered the previous submission, so its timestamps are ready
+    if (gpuQueryPending) {
+        uint64_t timestamps[2];
+        if (vkGetQueryPoolResults(device, timestampPool, 0, 2, sizeof(timestamps), timestamps,
+                                  sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+            uint64_t gpuNs = static_cast<uint64_t>(static_cast<double>(timestamps[1] - timestamps[0]) * timestampPeriodNs);
+            gFrameStats.addTime(gpuQueryFrame, FramePhase::Gpu, gpuNs);
+        }
+        gpuQueryPending = false;
+    }
+    
     uint32_t imageIndex;
     vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
     
@@ -391,13 +458,18 @@ void Renderer::drawFrame() {
         throw std::runtime_error("Failed to begin recording command buffer!");
     }
     
+    if (timestampPool != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(commandBuffer, timestampPool, 0, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampPool, 0);
+    }
+    
     VkRenderPassBeginInfo renderPassBeginInfo{};
     renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassBeginInfo.renderPass = renderPass;
     renderPassBeginInfo.framebuffer = swapChainFramebuffers[imageIndex];
     renderPassBeginInfo.renderArea.extent = capabilities.currentExtent;
     
-    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+    VkClearValue clearColor = {{{snapshot.clearColor[0], snapshot.clearColor[1], snapshot.clearColor[2], snapshot.clearColor[3]}}};
     renderPassBeginInfo.clearValueCount = 1;
     renderPassBeginInfo.pClearValues = &clearColor;
     
@@ -406,6 +478,10 @@ void Renderer::drawFrame() {
     vkCmdDraw(commandBuffer, 3, 1, 0, 0); // Draw a triangle
     vkCmdEndRenderPass(commandBuffer);
     
+    if (timestampPool != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampPool, 1);
+    }
+    
     if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
         throw std::runtime_error("Failed to record command buffer!");
     }
@@ -428,6 +504,9 @@ void Renderer::drawFrame() {
     if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFence) != VK_SUCCESS) {
         throw std::runtime_error("Failed to submit draw command buffer!");
     }
+    gLatencyTracer.onFrameStage(LatencyStage::Submit, snapshot.latencyEvents);
+    gpuQueryPending = timestampPool != VK_NULL_HANDLE;
+    gpuQueryFrame = snapshot.frameIndex;
     
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -440,6 +519,10 @@ void Renderer::drawFrame() {
     presentInfo.pImageIndices = &imageIndex;
     
     vkQueuePresentKHR(graphicsQueue, &presentInfo);
+    
+    // Returning from present is the closest CPU-side point to scan-out the swapchain exposes
+    gLatencyTracer.onFrameStage(LatencyStage::Present, snapshot.latencyEvents);
+    gFrameStats.onPresent(snapshot.frameIndex);
 }
 
 void Renderer::cleanup() {
@@ -450,6 +533,9 @@ void Renderer::cleanup() {
     vkDestroySemaphore(device, renderFinishedSemaphore, nullptr);
     vkDestroySemaphore(device, imageAvailableSemaphore, nullptr);
     vkDestroyFence(device, inFlightFence, nullptr);
+    if (timestampPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(device, timestampPool, nullptr);
+    }
     vkDestroyCommandPool(device, commandPool, nullptr);
     vkDestroyPipeline(device, graphicsPipeline, nullptr);
     vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
@@ -473,6 +559,7 @@ void Renderer::cleanup() {
 }
 
 void Renderer::handleWindowResize(int width, int height) {
+    MEMORY_TAG_SCOPE(Memory::Tag::Renderer);
     // Wait until the device is idle before recreating resources
     vkDeviceWaitIdle(device);
     
@@ -0,0 +1,315 @@
+#include <threading/job_system.hpp>
+#include <threading/threading.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace Threading {
+
+JobSystem Jobs;
+
+namespace {
+    // Index of the calling thread in the job system, -1 outside it
+    thread_local int currentWorker = -1;
+
+    // Rounds of failed stealing before an idle worker goes to sleep
+    constexpr int IDLE_SPINS = 64;
+
+    uint64_t nextRandom(uint64_t& state) {
+        // xorshift64*, only used to pick steal victims
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+}
+
+JobDeque::JobDeque() : jobs(new std::atomic<Job*>[CAPACITY]) {
+}
+
+bool JobDeque::push(Job* job) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY) {
+        return false;
+    }
+    jobs[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+    // Publishes the job's contents to thieves that acquire bottom
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+Job* JobDeque::pop() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        // Empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = jobs[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last job: race the thieves for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobDeque::steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+        return nullptr;
+    }
+
+    Job* job = jobs[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr; // lost to another thief or the owner
+    }
+    return job;
+}
+
+JobSystem::~JobSystem() {
+    stop();
+}
+
+void JobSystem::start(int workerCount) {
+    if (isRunning()) {
+        return;
+    }
+
+    if (workerCount <= 0) {
+        workerCount = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+    }
+
+    workers.clear();
+    for (int i = 0; i < workerCount; i++) {
+        auto worker = std::make_unique<Worker>();
+        worker->pool.reset(new Job[JOB_POOL_SIZE]);
+        worker->stealSeed = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(i + 1);
+        workers.push_back(std::move(worker));
+    }
+    externalPool.reset(new Job[JOB_POOL_SIZE]);
+    injectionQueue.reserve(JOB_POOL_SIZE);
+
+    running.store(true, std::memory_order_release);
+    currentWorker = 0;
+    for (int i = 1; i < workerCount; i++) {
+        workers[i]->thread = createThread(configForRole(ThreadRole::Worker, "worker " + std::to_string(i)),
+                                          [this, i]() { workerMain(i); });
+    }
+
+    std::cout << "Job system started with " << workerCount << " workers" << std::endl;
+}
+
+void JobSystem::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    running.store(false, std::memory_order_release);
+    wakeWorkers();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    workers.clear();
+    currentWorker = -1;
+}
+
+Job* JobSystem::allocateJob() {
+    // Pools are rings; only the owning thread (or the injection lock holder)
+    // allocates, so the next free slot can be claimed without a CAS
+    if (currentWorker >= 0) {
+        Worker& worker = *workers[currentWorker];
+        return claimSlot(worker.pool.get(), worker.nextPoolJob);
+    }
+    std::lock_guard<std::mutex> lock(injectionMutex);
+    return claimSlot(externalPool.get(), nextExternalJob);
+}
+
+Job* JobSystem::claimSlot(Job* pool, size_t& next) {
+    for (size_t attempt = 0; attempt < JOB_POOL_SIZE; attempt++) {
+        Job* job = &pool[next++ & (JOB_POOL_SIZE - 1)];
+        if (!job->busy.load(std::memory_order_acquire)) {
+            job->busy.store(true, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    std::cerr << "Job pool exhausted: " << JOB_POOL_SIZE << " unfinished jobs from one thread" << std::endl;
+    std::abort();
+}
+
+void JobSystem::schedule(Job* job) {
+    if (!isRunning()) {
+        execute(job);
+        return;
+    }
+
+    if (currentWorker >= 0) {
+        if (!workers[currentWorker]->deque.push(job)) {
+            execute(job); // deque full, run it here
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        injectionQueue.push_back(job);
+        injectionCount.fetch_add(1, std::memory_order_release);
+    }
+    wakeWorkers();
+}
+
+void JobSystem::scheduleAfter(JobCounter& dependency, Job* job) {
+    uint32_t state = dependency.state.load(std::memory_order_relaxed);
+    while ((state & JobCounter::LOCKED) ||
+           !dependency.state.compare_exchange_weak(state, state | JobCounter::LOCKED, std::memory_order_acquire)) {
+        if (state & JobCounter::LOCKED) {
+            std::this_thread::yield();
+            state = dependency.state.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (state == 0) {
+        dependency.state.fetch_and(~JobCounter::LOCKED, std::memory_order_release);
+        schedule(job);
+        return;
+    }
+    job->nextWaiter = dependency.waiters;
+    dependency.waiters = job;
+    dependency.state.fetch_and(~JobCounter::LOCKED, std::memory_order_release);
+}
+
+void JobSystem::execute(Job* job) {
+    // Once the slot is released its owner may reuse it, so take the counter first
+    JobCounter* counter = job->counter;
+    job->function(*job);
+    job->busy.store(false, std::memory_order_release);
+    if (counter) {
+        finish(*counter);
+    }
+}
+
+void JobSystem::finish(JobCounter& counter) {
+    // Any job but the last just decrements
+    uint32_t state = counter.state.load(std::memory_order_relaxed);
+    for (;;) {
+        if (state & JobCounter::LOCKED) {
+            std::this_thread::yield();
+            state = counter.state.load(std::memory_order_relaxed);
+        } else if (state > 1) {
+            if (counter.state.compare_exchange_weak(state, state - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        } else if (counter.state.compare_exchange_weak(state, state | JobCounter::LOCKED, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    // The last job takes the waiters, then drops its count and the lock in one
+    // step; after that store the counter may already be gone
+    Job* waiter = counter.waiters;
+    counter.waiters = nullptr;
+    counter.state.fetch_sub(JobCounter::LOCKED + 1, std::memory_order_acq_rel);
+
+    while (waiter) {
+        Job* next = waiter->nextWaiter;
+        schedule(waiter);
+        waiter = next;
+    }
+}
+
+Job* JobSystem::findJob(int workerIndex) {
+    if (workerIndex >= 0) {
+        if (Job* job = workers[workerIndex]->deque.pop()) {
+            return job;
+        }
+    }
+
+    if (injectionCount.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        if (!injectionQueue.empty()) {
+            Job* job = injectionQueue.back();
+            injectionQueue.pop_back();
+            injectionCount.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // Steal, starting from a random victim so thieves spread out
+    size_t count = workers.size();
+    if (workerIndex < 0 || count < 2) {
+        return nullptr;
+    }
+    size_t start = static_cast<size_t>(nextRandom(workers[workerIndex]->stealSeed) % count);
+    for (size_t i = 0; i < count; i++) {
+        size_t victim = (start + i) % count;
+        if (victim == static_cast<size_t>(workerIndex)) {
+            continue;
+        }
+        if (Job* job = workers[victim]->deque.steal()) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (Job* job = findJob(currentWorker)) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int JobSystem::currentWorkerIndex() {
+    return currentWorker;
+}
+
+void JobSystem::workerMain(int workerIndex) {
+    currentWorker = workerIndex;
+    int idleRounds = 0;
+
+    while (isRunning()) {
+        uint64_t epoch = workEpoch.load(std::memory_order_acquire);
+        if (Job* job = findJob(workerIndex)) {
+            execute(job);
+            idleRounds = 0;
+            continue;
+        }
+
+        if (++idleRounds < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Sleep unless work was published since the last search
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1, std::memory_order_acq_rel);
+        sleepCondition.wait(lock, [&]() {
+            return workEpoch.load(std::memory_order_acquire) != epoch || !isRunning();
+        });
+        sleepingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+        idleRounds = 0;
+    }
+}
+
+void JobSystem::wakeWorkers() {
+    workEpoch.fetch_add(1, std::memory_order_acq_rel);
+    if (sleepingWorkers.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        sleepCondition.notify_all();
+    }
+}
+
+} // namespace Threading
@@ -0,0 +1,187 @@
+#include <threading/task_graph.hpp>
+#include <profiling/profiler.hpp>
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace Threading {
+
+TaskGraph::SystemId TaskGraph::addSystem(const std::string& name,
+                                         std::initializer_list<const char*> reads,
+                                         std::initializer_list<const char*> writes,
+                                         std::function<void()> run) {
+    System system;
+    system.name = name;
+    system.run = std::move(run);
+    for (const char* resource : reads) {
+        system.reads.push_back(resourceId(resource));
+    }
+    for (const char* resource : writes) {
+        system.writes.push_back(resourceId(resource));
+    }
+
+    systems.push_back(std::move(system));
+    dirty = true;
+    return static_cast<SystemId>(systems.size() - 1);
+}
+
+TaskGraph::ResourceId TaskGraph::resourceId(const char* name) {
+    auto it = resourceIds.find(name);
+    if (it != resourceIds.end()) {
+        return it->second;
+    }
+    ResourceId id = static_cast<ResourceId>(resourceNames.size());
+    resourceIds.emplace(name, id);
+    resourceNames.push_back(name);
+    return id;
+}
+
+void TaskGraph::addEdge(SystemId from, SystemId to, ResourceId resource) {
+    if (from == to) {
+        return;
+    }
+    std::vector<Edge>& successors = systems[from].successors;
+    bool exists = std::any_of(successors.begin(), successors.end(), [to](const Edge& edge) { return edge.to == to; });
+    if (!exists) {
+        successors.push_back({to, resource});
+        systems[to].dependencyCount++;
+    }
+}
+
+void TaskGraph::build() {
+    for (System& system : systems) {
+        system.successors.clear();
+        system.dependencyCount = 0;
+    }
+
+    // Walk the systems in the order they were added, tracking per resource the
+    // last writer and the readers since then
+    const SystemId NONE = 0xFFFF;
+    std::vector<SystemId> lastWriter(resourceNames.size(), NONE);
+    std::vector<std::vector<SystemId>> readers(resourceNames.size());
+
+    for (size_t index = 0; index < systems.size(); index++) {
+        SystemId id = static_cast<SystemId>(index);
+        const System& system = systems[index];
+
+        for (ResourceId resource : system.reads) {
+            if (lastWriter[resource] != NONE) {
+                addEdge(lastWriter[resource], id, resource);
+            }
+            readers[resource].push_back(id);
+        }
+        for (ResourceId resource : system.writes) {
+            // Readers already follow the last writer, so they alone are enough
+            if (!readers[resource].empty()) {
+                for (SystemId reader : readers[resource]) {
+                    addEdge(reader, id, resource);
+                }
+            } else if (lastWriter[resource] != NONE) {
+                addEdge(lastWriter[resource], id, resource);
+            }
+            lastWriter[resource] = id;
+            readers[resource].clear();
+        }
+    }
+
+    roots.clear();
+    for (size_t index = 0; index < systems.size(); index++) {
+        if (systems[index].dependencyCount == 0) {
+            roots.push_back(static_cast<SystemId>(index));
+        }
+    }
+
+    remaining.reset(new std::atomic<uint32_t>[systems.size()]);
+    timings.assign(systems.size(), Timing{});
+    dirty = false;
+}
+
+void TaskGraph::execute(JobSystem& jobs) {
+    if (systems.empty()) {
+        return;
+    }
+    if (dirty) {
+        build();
+    }
+
+    for (size_t index = 0; index < systems.size(); index++) {
+        remaining[index].store(systems[index].dependencyCount, std::memory_order_relaxed);
+    }
+
+    recordTimings = !exportPath.empty();
+    uint64_t frameStartNs = SDL_GetTicksNS();
+
+    // Successors are submitted by the system that finishes last before it
+    // completes, so the counter only drops to zero once the whole graph ran
+    JobCounter counter;
+    activeJobs = &jobs;
+    activeCounter = &counter;
+    for (SystemId root : roots) {
+        jobs.submit([this, root]() { runSystem(root); }, &counter);
+    }
+    jobs.wait(counter);
+    activeJobs = nullptr;
+    activeCounter = nullptr;
+
+    if (recordTimings) {
+        if (writeGraph(exportPath, frameStartNs)) {
+            std::cout << "Frame graph written to " << exportPath << std::endl;
+        }
+        exportPath.clear();
+        recordTimings = false;
+    }
+}
+
+void TaskGraph::runSystem(SystemId id) {
+    System& system = systems[id];
+    PROFILE_SCOPE(system.name.c_str());
+    if (recordTimings) {
+        timings[id].startNs = SDL_GetTicksNS();
+        timings[id].worker = JobSystem::currentWorkerIndex();
+    }
+
+    system.run();
+
+    if (recordTimings) {
+        timings[id].endNs = SDL_GetTicksNS();
+    }
+
+    for (const Edge& edge : system.successors) {
+        if (remaining[edge.to].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            SystemId next = edge.to;
+            activeJobs->submit([this, next]() { runSystem(next); }, activeCounter);
+        }
+    }
+}
+
+bool TaskGraph::writeGraph(const std::string& path, uint64_t frameStartNs) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open frame graph file: " << path << std::endl;
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "digraph frame {\n";
+    file << "    rankdir=LR;\n";
+    file << "    node [shape=box, fontname=\"monospace\"];\n";
+    for (size_t index = 0; index < systems.size(); index++) {
+        const Timing& timing = timings[index];
+        file << "    s" << index << " [label=\"" << systems[index].name
+             << "\\nstart +" << (timing.startNs - frameStartNs) / 1e6 << " ms"
+             << "\\ntook " << (timing.endNs - timing.startNs) / 1e6 << " ms"
+             << "\\nworker " << timing.worker << "\"];\n";
+    }
+    for (size_t index = 0; index < systems.size(); index++) {
+        for (const Edge& edge : systems[index].successors) {
+            file << "    s" << index << " -> s" << edge.to
+                 << " [label=\"" << resourceNames[edge.resource] << "\"];\n";
+        }
+    }
+    file << "}\n";
+    return true;
+}
+
+} // namespace Threading
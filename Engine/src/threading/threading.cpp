@@ -0,0 +1,254 @@
+#include <threading/threading.hpp>
+#include <settings/settings.hpp>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+namespace Threading {
+
+namespace {
+    std::mutex reportsMutex;
+    std::vector<ThreadReport> reports;
+    bool memoryLockAttempted = false;
+    bool memoryLockGranted = false;
+    thread_local std::string currentName;
+
+    // Touch the requested amount of stack so later real-time code never faults it in
+    bool prefaultStack(size_t bytes) {
+        if (bytes == 0) {
+            return false;
+        }
+
+        // Recurse first so every frame's buffer stays live (no tail call reuse)
+        constexpr size_t CHUNK = 16 * 1024;
+        char buffer[CHUNK];
+        if (bytes > CHUNK) {
+            prefaultStack(bytes - CHUNK);
+        }
+        // Writes through a volatile pointer can't be optimized away
+        volatile char* touch = buffer;
+        for (size_t i = 0; i < CHUNK; i += 64) {
+            touch[i] = 0;
+        }
+        return true;
+    }
+
+    bool setName(const std::string& name) {
+        if (name.empty()) {
+            return false;
+        }
+#if defined(_WIN32)
+        std::wstring wideName(name.begin(), name.end());
+        return SUCCEEDED(SetThreadDescription(GetCurrentThread(), wideName.c_str()));
+#elif defined(__linux__)
+        // Linux limits thread names to 15 characters plus the terminator
+        return pthread_setname_np(pthread_self(), name.substr(0, 15).c_str()) == 0;
+#elif defined(__APPLE__)
+        return pthread_setname_np(name.c_str()) == 0;
+#else
+        return false;
+#endif
+    }
+
+    bool setAffinity(uint64_t mask) {
+        if (mask == 0) {
+            return false;
+        }
+#if defined(_WIN32)
+        return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64; cpu++) {
+            if (mask & (uint64_t(1) << cpu)) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        return false; // macOS only offers affinity hints
+#endif
+    }
+
+    // Raise priority without a real-time class; returns true if granted
+    bool setHighPriority() {
+#if defined(_WIN32)
+        return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL) != 0;
+#elif defined(__linux__)
+        // Niceness is per thread on Linux
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        return setpriority(PRIO_PROCESS, static_cast<id_t>(tid), -10) == 0;
+#else
+        return false;
+#endif
+    }
+
+    bool setRealTime(SchedulingClass schedulingClass) {
+#if defined(_WIN32)
+        (void)schedulingClass;
+        return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+#elif defined(__linux__) || defined(__APPLE__)
+        int policy = schedulingClass == SchedulingClass::RealTimeFifo ? SCHED_FIFO : SCHED_RR;
+        sched_param param{};
+        // Stay below the kernel's own real-time threads
+        param.sched_priority = (sched_get_priority_min(policy) + sched_get_priority_max(policy)) / 2;
+        return pthread_setschedparam(pthread_self(), policy, &param) == 0;
+#else
+        (void)schedulingClass;
+        return false;
+#endif
+    }
+
+    bool lockMemory() {
+        // mlockall is process wide, so only try once
+        if (memoryLockAttempted) {
+            return memoryLockGranted;
+        }
+        memoryLockAttempted = true;
+#if defined(__linux__)
+        memoryLockGranted = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+        return memoryLockGranted;
+    }
+}
+
+ThreadReport applyToCurrentThread(const ThreadConfig& config) {
+    ThreadReport report;
+    report.name = config.name;
+    report.requested = config.schedulingClass;
+    report.requestedAffinity = config.affinityMask;
+    report.nameApplied = setName(config.name);
+    currentName = config.name;
+    report.affinityApplied = setAffinity(config.affinityMask);
+
+    // Fall back one class at a time until the OS accepts the request
+    switch (config.schedulingClass) {
+        case SchedulingClass::RealTimeFifo:
+        case SchedulingClass::RealTimeRoundRobin:
+            if (setRealTime(config.schedulingClass)) {
+                report.granted = config.schedulingClass;
+                break;
+            }
+            // fall through
+        case SchedulingClass::High:
+            report.granted = setHighPriority() ? SchedulingClass::High : SchedulingClass::Normal;
+            break;
+        case SchedulingClass::Normal:
+            report.granted = SchedulingClass::Normal;
+            break;
+    }
+
+    report.stackPrefaulted = prefaultStack(config.prefaultStackBytes);
+
+    {
+        std::lock_guard<std::mutex> lock(reportsMutex);
+        if (config.lockMemory) {
+            report.memoryLocked = lockMemory();
+        }
+
+        // Short-lived threads reuse their name; keep one report per name and
+        // only print again if the OS answered differently this time
+        auto existing = std::find_if(reports.begin(), reports.end(),
+                                     [&report](const ThreadReport& r) { return r.name == report.name; });
+        if (existing != reports.end()) {
+            bool unchanged = existing->granted == report.granted && existing->affinityApplied == report.affinityApplied;
+            *existing = report;
+            if (unchanged) {
+                return report;
+            }
+        } else {
+            reports.push_back(report);
+        }
+    }
+
+    std::cout << "Thread '" << report.name << "': requested " << schedulingClassName(report.requested)
+              << ", granted " << schedulingClassName(report.granted);
+    if (config.affinityMask != 0) {
+        std::cout << ", affinity 0x" << std::hex << config.affinityMask << std::dec
+                  << (report.affinityApplied ? " applied" : " refused");
+    }
+    if (config.lockMemory) {
+        std::cout << ", memory " << (report.memoryLocked ? "locked" : "not locked");
+    }
+    std::cout << std::endl;
+
+    return report;
+}
+
+const std::string& currentThreadName() {
+    return currentName;
+}
+
+ThreadConfig configForRole(ThreadRole role, const std::string& name) {
+    ThreadConfig config;
+    config.name = name;
+
+    switch (role) {
+        case ThreadRole::Main:
+            config.schedulingClass = parseSchedulingClass(g_settings.mainThreadPriority);
+            config.affinityMask = g_settings.mainThreadAffinity;
+            break;
+        case ThreadRole::Audio:
+            config.schedulingClass = parseSchedulingClass(g_settings.audioThreadPriority);
+            config.affinityMask = g_settings.audioThreadAffinity;
+            break;
+        case ThreadRole::Input:
+            config.schedulingClass = parseSchedulingClass(g_settings.inputThreadPriority);
+            config.affinityMask = g_settings.inputThreadAffinity;
+            break;
+        case ThreadRole::Worker:
+            config.schedulingClass = parseSchedulingClass(g_settings.workerThreadPriority);
+            config.affinityMask = g_settings.workerThreadAffinity;
+            break;
+    }
+
+    // Real-time threads get their stack and pages faulted in up front
+    if (config.schedulingClass == SchedulingClass::RealTimeFifo ||
+        config.schedulingClass == SchedulingClass::RealTimeRoundRobin) {
+        config.prefaultStackBytes = 256 * 1024;
+        config.lockMemory = g_settings.lockMemory;
+    }
+
+    return config;
+}
+
+std::vector<ThreadReport> getThreadReports() {
+    std::lock_guard<std::mutex> lock(reportsMutex);
+    return reports;
+}
+
+SchedulingClass parseSchedulingClass(const std::string& value) {
+    if (value == "high") return SchedulingClass::High;
+    if (value == "rr" || value == "realtime") return SchedulingClass::RealTimeRoundRobin;
+    if (value == "fifo") return SchedulingClass::RealTimeFifo;
+    return SchedulingClass::Normal;
+}
+
+const char* schedulingClassName(SchedulingClass schedulingClass) {
+    switch (schedulingClass) {
+        case SchedulingClass::High: return "high";
+        case SchedulingClass::RealTimeRoundRobin: return "rr";
+        case SchedulingClass::RealTimeFifo: return "fifo";
+        case SchedulingClass::Normal:
+        default:
+            return "normal";
+    }
+}
+
+} // namespace Threading
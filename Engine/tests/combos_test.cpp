@@ -0,0 +1,144 @@
+#include "test_check.hpp"
+#include <inputs/combos.hpp>
+#include <cstdint>
+#include <vector>
+
+// Sequences, chords in either press order, step and chord windows, unrelated
+// presses and presses that break a combo
+
+using namespace Keyboard;
+
+namespace {
+    constexpr uint64_t MS = 1000000;
+}
+
+int main() {
+    KeyboardManager input("");
+    ActionId right = input.registerAction("MOVE_RIGHT");
+    ActionId back = input.registerAction("MOVE_BACKWARD");
+    ActionId attack = input.registerAction("ATTACK");
+    ActionId crouch = input.registerAction("CROUCH");
+    ActionId jump = input.registerAction("JUMP");
+
+    ComboMatcher combos;
+    ComboDefinition dash;
+    dash.name = "DASH_FORWARD";
+    dash.steps = {{right}, {right}};
+    dash.stepWindowMs = 200;
+    combos.addCombo(dash);
+
+    ComboDefinition fireball;
+    fireball.name = "FIREBALL";
+    fireball.steps = {{back}, {right}, {attack}};
+    fireball.stepWindowMs = 300;
+    combos.addCombo(fireball);
+
+    // 4! press orders fit, 5! don't and the combo is left out
+    ComboDefinition fourChord;
+    fourChord.name = "FOUR_CHORD";
+    fourChord.steps = {{input.registerAction("A1"), input.registerAction("A2"), input.registerAction("A3"), input.registerAction("A4")}};
+    combos.addCombo(fourChord);
+
+    ComboDefinition fiveChord;
+    fiveChord.name = "FIVE_CHORD";
+    fiveChord.steps = {{input.registerAction("B1"), input.registerAction("B2"), input.registerAction("B3"),
+                        input.registerAction("B4"), input.registerAction("B5")}};
+    combos.addCombo(fiveChord);
+
+    ComboDefinition crouchAttack;
+    crouchAttack.name = "CROUCH_ATTACK";
+    crouchAttack.steps = {{crouch, attack}};
+    crouchAttack.chordWindowMs = 50;
+    combos.addCombo(crouchAttack);
+    combos.compile();
+
+    ComboId dashId = combos.getComboId("DASH_FORWARD");
+    ComboId fireballId = combos.getComboId("FIREBALL");
+    ComboId crouchAttackId = combos.getComboId("CROUCH_ATTACK");
+    CHECK(combos.getComboId("MISSING") == INVALID_COMBO);
+
+    uint64_t t = 1000 * MS;
+    combos.onActionPressed(right, t);
+    combos.onActionPressed(right, t + 100 * MS);
+    combos.update();
+    CHECK(combos.isComboTriggered(dashId));
+    combos.update();
+    CHECK(!combos.isComboTriggered(dashId)); // only for one frame
+
+    // Too slow, then the late press starts a new dash in time
+    combos.onActionPressed(right, t + 1000 * MS);
+    combos.onActionPressed(right, t + 1400 * MS);
+    combos.update();
+    CHECK(!combos.isComboTriggered(dashId));
+    combos.onActionPressed(right, t + 1500 * MS);
+    combos.update();
+    CHECK(combos.isComboTriggered(dashId));
+
+    // Chords match in either order, within the chord window only
+    t += 5000 * MS;
+    combos.onActionPressed(attack, t);
+    combos.onActionPressed(crouch, t + 30 * MS);
+    combos.update();
+    CHECK(combos.isComboTriggered(crouchAttackId));
+    combos.onActionPressed(crouch, t + 1000 * MS);
+    combos.onActionPressed(attack, t + 1080 * MS);
+    combos.update();
+    CHECK(!combos.isComboTriggered(crouchAttackId));
+
+    // Oversized chords
+    t += 5000 * MS;
+    const std::vector<ActionId>& fourKeys = fourChord.steps[0];
+    const std::vector<ActionId>& fiveKeys = fiveChord.steps[0];
+    for (size_t i = 0; i < fourKeys.size(); i++) {
+        combos.onActionPressed(fourKeys[fourKeys.size() - 1 - i], t + i * MS);
+    }
+    combos.update();
+    CHECK(combos.isComboTriggered(combos.getComboId("FOUR_CHORD")));
+    for (size_t i = 0; i < fiveKeys.size(); i++) {
+        combos.onActionPressed(fiveKeys[i], t + 1000 * MS + i * MS);
+    }
+    combos.update();
+    CHECK(!combos.isComboTriggered(combos.getComboId("FIVE_CHORD")));
+
+    // Actions no combo uses are ignored
+    t += 5000 * MS;
+    combos.onActionPressed(back, t);
+    combos.onActionPressed(jump, t + 10 * MS);
+    combos.onActionPressed(right, t + 200 * MS);
+    combos.onActionPressed(attack, t + 400 * MS);
+    combos.update();
+    CHECK(combos.isComboTriggered(fireballId));
+
+    // Actions another combo uses break the sequence
+    t += 5000 * MS;
+    combos.onActionPressed(back, t);
+    combos.onActionPressed(crouch, t + 10 * MS);
+    combos.onActionPressed(right, t + 200 * MS);
+    combos.onActionPressed(attack, t + 400 * MS);
+    combos.update();
+    CHECK(!combos.isComboTriggered(fireballId));
+
+    // Presses arrive through the input manager once attached
+    int callbacks = 0;
+    combos.registerComboCallback(dashId, [&callbacks]() { callbacks++; });
+    input.mapAction("MOVE_RIGHT", SDLK_D);
+    combos.attach(input);
+    t += 5000 * MS;
+    for (int i = 0; i < 2; i++) {
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = SDL_EVENT_KEY_DOWN;
+        event.key.key = SDLK_D;
+        event.key.scancode = SDL_SCANCODE_D;
+        event.key.down = true;
+        event.common.timestamp = t + i * 50 * MS;
+        input.handleEvent(event);
+        event.type = SDL_EVENT_KEY_UP;
+        event.key.down = false;
+        input.handleEvent(event);
+    }
+    combos.update();
+    CHECK(combos.isComboTriggered(dashId));
+    CHECK(callbacks == 1);
+    return 0;
+}
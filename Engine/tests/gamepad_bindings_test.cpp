@@ -0,0 +1,134 @@
+#include "test_check.hpp"
+#include <inputs/keyboard.hpp>
+#include <SDL3/SDL.h>
+
+// Gamepad bindings driven through an SDL virtual gamepad: button press, hold
+// and release, the axis deadzone and both halves of an axis, a key and a
+// button bound to one action, and everything released when the pad goes away
+
+using namespace Keyboard;
+
+namespace {
+    constexpr float DEADZONE = 0.25f;
+
+    Sint16 axisValue(float value) {
+        return static_cast<Sint16>(value * 32767.0f);
+    }
+
+    SDL_Event keyEvent(bool down) {
+        SDL_Event event{};
+        event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+        event.key.key = SDLK_SPACE;
+        event.key.scancode = SDL_SCANCODE_SPACE;
+        event.key.down = down;
+        return event;
+    }
+
+    // Hands everything SDL queued for the virtual pad to the input manager,
+    // then starts the next input frame
+    void frame(KeyboardManager& input) {
+        SDL_UpdateJoysticks();
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            input.handleEvent(event);
+        }
+        input.update();
+    }
+}
+
+int main() {
+    CHECK(SDL_Init(SDL_INIT_GAMEPAD));
+
+    KeyboardManager input("");
+    ActionId jump = input.mapAction("JUMP", SDLK_SPACE);
+    input.bindAction("JUMP", InputBinding{InputSource::GamepadButton, SDL_GAMEPAD_BUTTON_SOUTH});
+    ActionId fire = input.bindAction("FIRE", InputBinding{InputSource::GamepadButton, SDL_GAMEPAD_BUTTON_EAST});
+    ActionId right = input.bindAction("MOVE_RIGHT", InputBinding{InputSource::GamepadAxis, SDL_GAMEPAD_AXIS_LEFTX, false, DEADZONE});
+    ActionId left = input.bindAction("MOVE_LEFT", InputBinding{InputSource::GamepadAxis, SDL_GAMEPAD_AXIS_LEFTX, true, DEADZONE});
+
+    SDL_VirtualJoystickDesc desc;
+    SDL_INIT_INTERFACE(&desc);
+    desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+    desc.naxes = SDL_GAMEPAD_AXIS_COUNT;
+    desc.nbuttons = SDL_GAMEPAD_BUTTON_COUNT;
+    desc.axis_mask = (1u << SDL_GAMEPAD_AXIS_COUNT) - 1;
+    desc.button_mask = (1u << SDL_GAMEPAD_BUTTON_COUNT) - 1;
+    desc.name = "Test Pad";
+    SDL_JoystickID padId = SDL_AttachVirtualJoystick(&desc);
+    CHECK(padId != 0);
+    SDL_Joystick* pad = SDL_OpenJoystick(padId);
+    CHECK(pad != nullptr);
+    frame(input); // GAMEPAD_ADDED opens the pad on the input side
+
+    // Press, hold and release
+    SDL_SetJoystickVirtualButton(pad, SDL_GAMEPAD_BUTTON_SOUTH, true);
+    frame(input);
+    CHECK(input.isActionPressed(jump));
+    CHECK(input.isActionJustPressed(jump));
+    frame(input);
+    CHECK(input.isActionPressed(jump));
+    CHECK(!input.isActionJustPressed(jump));
+    SDL_SetJoystickVirtualButton(pad, SDL_GAMEPAD_BUTTON_SOUTH, false);
+    frame(input);
+    CHECK(!input.isActionPressed(jump));
+    CHECK(input.isActionJustReleased(jump));
+
+    // Inside the deadzone the axis reads as 0
+    SDL_SetJoystickVirtualAxis(pad, SDL_GAMEPAD_AXIS_LEFTX, axisValue(0.2f));
+    frame(input);
+    CHECK(input.getActionValue(right) == 0.0f);
+    CHECK(!input.isActionPressed(right));
+
+    // Past it the value is rescaled, and counts as pressed from halfway
+    SDL_SetJoystickVirtualAxis(pad, SDL_GAMEPAD_AXIS_LEFTX, axisValue(0.5f));
+    frame(input);
+    CHECK(input.getActionValue(right) > 0.0f);
+    CHECK(!input.isActionPressed(right));
+    SDL_SetJoystickVirtualAxis(pad, SDL_GAMEPAD_AXIS_LEFTX, axisValue(0.9f));
+    frame(input);
+    CHECK(input.isActionPressed(right));
+    CHECK(!input.isActionPressed(left));
+
+    // The other half of the same axis
+    SDL_SetJoystickVirtualAxis(pad, SDL_GAMEPAD_AXIS_LEFTX, axisValue(-0.9f));
+    frame(input);
+    CHECK(input.isActionPressed(left));
+    CHECK(!input.isActionPressed(right));
+    CHECK(input.isActionJustReleased(right));
+    SDL_SetJoystickVirtualAxis(pad, SDL_GAMEPAD_AXIS_LEFTX, 0);
+    frame(input);
+    CHECK(!input.isActionPressed(left));
+
+    // A key and a button on one action: held while either one is down
+    input.handleEvent(keyEvent(true));
+    frame(input);
+    CHECK(input.isActionPressed(jump));
+    SDL_SetJoystickVirtualButton(pad, SDL_GAMEPAD_BUTTON_SOUTH, true);
+    frame(input);
+    input.handleEvent(keyEvent(false));
+    frame(input);
+    CHECK(input.isActionPressed(jump));
+    SDL_SetJoystickVirtualButton(pad, SDL_GAMEPAD_BUTTON_SOUTH, false);
+    frame(input);
+    CHECK(!input.isActionPressed(jump));
+
+    // Unplugging the pad releases whatever it was holding
+    SDL_SetJoystickVirtualButton(pad, SDL_GAMEPAD_BUTTON_SOUTH, true);
+    SDL_SetJoystickVirtualButton(pad, SDL_GAMEPAD_BUTTON_EAST, true);
+    SDL_SetJoystickVirtualAxis(pad, SDL_GAMEPAD_AXIS_LEFTX, axisValue(0.9f));
+    frame(input);
+    CHECK(input.isActionPressed(jump));
+    CHECK(input.isActionPressed(fire));
+    CHECK(input.isActionPressed(right));
+    SDL_CloseJoystick(pad);
+    CHECK(SDL_DetachVirtualJoystick(padId));
+    frame(input);
+    CHECK(!input.isActionPressed(jump));
+    CHECK(!input.isActionPressed(fire));
+    CHECK(!input.isActionPressed(right));
+    CHECK(input.getActionValue(right) == 0.0f);
+    CHECK(input.isActionJustReleased(fire));
+
+    SDL_Quit();
+    return 0;
+}
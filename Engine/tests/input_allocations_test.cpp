@@ -0,0 +1,97 @@
+#include "test_check.hpp"
+#include <inputs/keyboard.hpp>
+#include <inputs/combos.hpp>
+#include <memory/memory_tracker.hpp>
+#include <cstdint>
+
+// Once warmed up, the per-frame input path (key, mouse and gamepad events,
+// the frame update, press listeners and combo matching) must not allocate
+
+using namespace Keyboard;
+
+namespace {
+    uint64_t totalAllocations() {
+        uint64_t total = 0;
+        for (int tag = 0; tag < static_cast<int>(Memory::Tag::Count); tag++) {
+            total += Memory::getTagStats(static_cast<Memory::Tag>(tag)).allocations;
+        }
+        return total;
+    }
+
+    SDL_Event keyEvent(SDL_Keycode key, bool down, uint64_t timestampNs) {
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+        event.key.key = key;
+        event.key.scancode = SDL_GetScancodeFromKey(key, nullptr);
+        event.key.down = down;
+        event.common.timestamp = timestampNs;
+        return event;
+    }
+
+    void runFrame(KeyboardManager& input, ComboMatcher& combos, uint64_t frame) {
+        uint64_t timestampNs = frame * 16000000;
+        SDL_Keycode key = (frame & 1) ? SDLK_D : SDLK_A;
+        input.handleEvent(keyEvent(key, true, timestampNs));
+        input.handleEvent(keyEvent(key, false, timestampNs + 1000000));
+
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+        event.button.button = SDL_BUTTON_LEFT;
+        event.button.down = (frame & 2) != 0;
+        event.common.timestamp = timestampNs;
+        input.handleEvent(event);
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_GAMEPAD_AXIS_MOTION;
+        event.gaxis.axis = SDL_GAMEPAD_AXIS_LEFTX;
+        event.gaxis.value = static_cast<Sint16>((frame * 997) % 65536 - 32768);
+        event.common.timestamp = timestampNs;
+        input.handleEvent(event);
+
+        input.update();
+        combos.update();
+    }
+}
+
+int main() {
+    if (!Memory::TRACKING_ENABLED) {
+        std::printf("Memory tracking is compiled out; nothing to check\n");
+        return 0;
+    }
+
+    // No configuration file: every binding is made here
+    KeyboardManager input("");
+    input.mapAction("MOVE_LEFT", SDLK_A);
+    input.mapAction("MOVE_RIGHT", SDLK_D);
+    input.bindAction("ATTACK", InputBinding{InputSource::MouseButton, SDL_BUTTON_LEFT});
+    input.bindAction("STEER", InputBinding{InputSource::GamepadAxis, SDL_GAMEPAD_AXIS_LEFTX});
+
+    ComboMatcher combos;
+    ComboDefinition wiggle;
+    wiggle.name = "WIGGLE";
+    wiggle.steps = {{input.getActionId("MOVE_LEFT")}, {input.getActionId("MOVE_RIGHT")}, {input.getActionId("MOVE_LEFT")}};
+    combos.addCombo(wiggle);
+    combos.compile();
+    combos.attach(input);
+    int wiggles = 0;
+    combos.registerComboCallback(combos.getComboId("WIGGLE"), [&wiggles]() { wiggles++; });
+
+    // Warm-up: lazily built tables and vectors reach their steady size
+    uint64_t frame = 0;
+    for (; frame < 64; frame++) {
+        runFrame(input, combos, frame);
+    }
+
+    uint64_t before = totalAllocations();
+    for (; frame < 64 + 1000; frame++) {
+        runFrame(input, combos, frame);
+    }
+    uint64_t allocations = totalAllocations() - before;
+
+    std::printf("%llu allocations over 1000 input frames\n", static_cast<unsigned long long>(allocations));
+    CHECK(wiggles > 0);
+    CHECK(allocations == 0);
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "test_check.hpp"
+#include <threading/job_system.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// submit, submitAfter, submissions from outside the system and parallelFor,
+// plus a job parked longer than it takes to cycle through a whole job pool
+
+using namespace Threading;
+
+int main() {
+    Jobs.start(4);
+
+    for (int round = 0; round < 200; round++) {
+        JobCounter first, after, external;
+        std::atomic<int> firstRuns{0}, externalRuns{0};
+        int seenByAfter = -1;
+
+        // Jobs that submit more jobs onto the same counter
+        for (int i = 0; i < 50; i++) {
+            Jobs.submit([&]() {
+                firstRuns++;
+                Jobs.submit([&]() { firstRuns++; }, &first);
+            }, &first);
+        }
+        Jobs.submitAfter(first, [&]() { seenByAfter = firstRuns.load(); }, &after);
+
+        std::thread submitter([&]() {
+            for (int i = 0; i < 10; i++) {
+                Jobs.submit([&]() { externalRuns++; }, &external);
+            }
+        });
+        submitter.join();
+
+        Jobs.wait(after);
+        Jobs.wait(external);
+        CHECK(seenByAfter == 100);
+        CHECK(externalRuns == 10);
+
+        std::atomic<uint64_t> sum{0};
+        Jobs.parallelFor(0, 10000, 7, [&](size_t first, size_t last) {
+            uint64_t partial = 0;
+            for (size_t i = first; i < last; i++) {
+                partial += i;
+            }
+            sum += partial;
+        });
+        CHECK(sum == 9999ull * 10000 / 2);
+    }
+
+    // A parked job keeps its slot while many more jobs than the pool holds run
+    JobCounter gate, parked, bulk;
+    std::atomic<bool> release{false};
+    std::atomic<int> parkedRuns{0}, bulkRuns{0};
+    Jobs.submit([&]() { while (!release.load()) { std::this_thread::yield(); } }, &gate);
+    Jobs.submitAfter(gate, [&]() { parkedRuns++; }, &parked);
+    for (size_t round = 0; round < 4; round++) {
+        for (size_t i = 0; i < JobSystem::JOB_POOL_SIZE / 2; i++) {
+            Jobs.submit([&]() { bulkRuns++; }, &bulk);
+        }
+        Jobs.wait(bulk);
+    }
+    release = true;
+    Jobs.wait(parked);
+    CHECK(parkedRuns == 1);
+    CHECK(bulkRuns == static_cast<int>(JobSystem::JOB_POOL_SIZE * 2));
+
+    Jobs.stop();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "test_check.hpp"
+#include <audio/mixer.hpp>
+#include <SDL3/SDL.h>
+
+// Device hot-switching on SDL's dummy audio driver: a format change that
+// leaves the rate alone keeps everything as it is, and losing the device
+// reopens it and re-prepares every playing voice at the new rate
+
+namespace {
+    constexpr int HELD_RATE = 96000;
+    constexpr int VOICE_MS = 1500;
+
+    SDL_Event deviceEvent(SDL_EventType type, SDL_AudioDeviceID device) {
+        SDL_Event event{};
+        event.type = type;
+        event.adevice.which = device;
+        event.adevice.recording = false;
+        return event;
+    }
+}
+
+int main() {
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    CHECK(SDL_Init(SDL_INIT_AUDIO));
+
+    // Holding a device open at a high rate makes the mixer's device share
+    // it; once let go, the reopened device comes back at the driver default
+    SDL_AudioSpec heldSpec{SDL_AUDIO_F32, 2, HELD_RATE};
+    SDL_AudioDeviceID held = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &heldSpec);
+    CHECK(held != 0);
+
+    InitializeAudioMixer();
+    AudioMixer& mixer = *gAudioMixer;
+    CHECK(mixer.GetSampleRate() == HELD_RATE);
+
+    mixer.PlayNote(Notes::A4, 440.0f, VOICE_MS);
+    mixer.PlaySound(660.0f, VOICE_MS);
+    mixer.AddSample("chord", WaveType::Sine, 261.63f, 0.3f);
+    mixer.AddSample("chord", WaveType::Square, 329.63f, 0.2f);
+    mixer.PlaySample("chord", VOICE_MS);
+    GranularParams grains;
+    CHECK(mixer.PlayGranular("chord", grains, VOICE_MS) >= 0);
+    CHECK(mixer.GetActiveChannelCount() == 4);
+    CHECK(mixer.GetActiveChannelCount(HELD_RATE) == 4);
+
+    // Same rate as before: nothing to re-prepare
+    mixer.HandleDeviceEvent(deviceEvent(SDL_EVENT_AUDIO_DEVICE_FORMAT_CHANGED, mixer.GetOutputDevice()));
+    CHECK(mixer.GetSampleRate() == HELD_RATE);
+    CHECK(mixer.GetActiveChannelCount(HELD_RATE) == 4);
+
+    // Some other device going away is none of the mixer's business
+    mixer.HandleDeviceEvent(deviceEvent(SDL_EVENT_AUDIO_DEVICE_REMOVED, held));
+    CHECK(mixer.GetSampleRate() == HELD_RATE);
+
+    SDL_CloseAudioDevice(held);
+
+    // Losing the device reopens the default one at its own rate, with every
+    // voice still playing and re-prepared for that rate
+    mixer.HandleDeviceEvent(deviceEvent(SDL_EVENT_AUDIO_DEVICE_REMOVED, mixer.GetOutputDevice()));
+    int defaultRate = mixer.GetSampleRate();
+    CHECK(defaultRate > 0 && defaultRate != HELD_RATE);
+    CHECK(mixer.GetActiveChannelCount() == 4);
+    CHECK(mixer.GetActiveChannelCount(defaultRate) == 4);
+
+    // A format change after the switch reports the rate the mixer already has
+    mixer.HandleDeviceEvent(deviceEvent(SDL_EVENT_AUDIO_DEVICE_FORMAT_CHANGED, mixer.GetOutputDevice()));
+    CHECK(mixer.GetActiveChannelCount(defaultRate) == 4);
+
+    // The voices still run out on their own schedule
+    for (int waited = 0; waited < VOICE_MS + 2000 && mixer.GetActiveChannelCount() > 0; waited += 50) {
+        SDL_Delay(50);
+    }
+    CHECK(mixer.GetActiveChannelCount() == 0);
+    SDL_Delay(200); // let the lifecycle threads drop their channels
+
+    ShutdownAudioMixer();
+    SDL_Quit();
+    return 0;
+}